@@ -0,0 +1,145 @@
+/*
+ * 基数排序离散化模板
+ * 千禧年科技学院 - 数据结构公共组件
+ *
+ * 常见写法 sort + unique + lower_bound 的问题：
+ * - sort 是 O(n log n) 的比较排序
+ * - 建树时每插入一个元素都要再 lower_bound 一次，又是 O(log n)
+ *
+ * 本模板的做法：
+ * 1. 把 (键, 下标) 对做 LSD 基数排序，每趟 8 位；
+ *    所有键在某一趟上取值相同时跳过这一趟
+ * 2. 扫描排好序的结果，去重的同时直接写出每个下标的排名 rank_at[i]
+ *
+ * 之后“第 i 个输入元素的离散化位置”就是 O(1) 的数组访问；
+ * 对任意值的查询 rank_of_value 仍保留二分查找。
+ *
+ * 支持 int32_t / uint32_t / int64_t / uint64_t（有符号数翻转符号位后按无符号排序）。
+ *
+ * 排序用的两个 (键, 下标) 缓冲区默认在 build 结束时释放；同一对象要反复 build
+ * （如 cdq_engine.h 的 PartialOrder3D）时调用 keep_buffers(true) 保留它们，规模不增大就不再分配内存。
+ *
+ * 时间复杂度：O(n · 位数/8)
+ * 空间复杂度：O(n)
+ */
+
+#ifndef RADIX_DISCRETIZER_H
+#define RADIX_DISCRETIZER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+template<typename Key>
+class RadixDiscretizer {
+    static_assert(std::is_integral<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8),
+                  "RadixDiscretizer 只支持 32/64 位整数");
+
+private:
+    typedef typename std::conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type UKey;
+
+    struct Item {
+        UKey key;
+        uint32_t index;
+    };
+
+    std::vector<Key> sorted_values;   // 排序去重后的值，排名 r 对应 sorted_values[r - 1]
+    std::vector<int> ranks;           // ranks[i]：第 i 个输入元素的排名（从1开始）
+    std::vector<Item> items, buffer;  // 基数排序的两个缓冲区
+    bool keep = false;                // build 结束后是否保留 items / buffer
+
+    // 有符号数翻转最高位，使无符号比较与有符号比较一致
+    static UKey to_unsigned(Key x) {
+        UKey u = (UKey)x;
+        if (std::is_signed<Key>::value) u ^= (UKey)1 << (sizeof(Key) * 8 - 1);
+        return u;
+    }
+
+    void radix_sort() {
+        size_t n = items.size();
+        buffer.resize(n);
+        size_t count[256];
+
+        for (int shift = 0; shift < (int)sizeof(UKey) * 8; shift += 8) {
+            memset(count, 0, sizeof(count));
+            for (size_t i = 0; i < n; i++) count[(items[i].key >> shift) & 255]++;
+
+            // 这一趟所有键的数字相同，无需移动
+            if (count[(items[0].key >> shift) & 255] == n) continue;
+
+            size_t sum = 0;
+            for (int d = 0; d < 256; d++) {
+                size_t c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+            for (size_t i = 0; i < n; i++) {
+                buffer[count[(items[i].key >> shift) & 255]++] = items[i];
+            }
+            items.swap(buffer);
+        }
+    }
+
+public:
+    RadixDiscretizer() {}
+
+    RadixDiscretizer(const Key* data, size_t n) { build(data, n); }
+
+    explicit RadixDiscretizer(const std::vector<Key>& data) { build(data.data(), data.size()); }
+
+    void build(const Key* data, size_t n) {
+        sorted_values.clear();
+        ranks.assign(n, 0);
+        if (n == 0) return;
+
+        items.resize(n);
+        for (size_t i = 0; i < n; i++) items[i] = Item{to_unsigned(data[i]), (uint32_t)i};
+
+        if (n < 64) {
+            std::sort(items.begin(), items.end(),
+                      [](const Item& a, const Item& b) { return a.key < b.key; });
+        } else {
+            radix_sort();
+        }
+
+        int rank = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (i == 0 || items[i].key != items[i - 1].key) {
+                sorted_values.push_back(data[items[i].index]);
+                rank++;
+            }
+            ranks[items[i].index] = rank;
+        }
+        if (!keep) {
+            std::vector<Item>().swap(items);
+            std::vector<Item>().swap(buffer);
+        }
+    }
+
+    void build(const std::vector<Key>& data) { build(data.data(), data.size()); }
+
+    // true：保留排序缓冲区供下一次 build 复用
+    void keep_buffers(bool value) { keep = value; }
+
+    // 第 i 个输入元素的排名（从1开始），O(1)
+    int rank_at(size_t i) const { return ranks[i]; }
+
+    // 任意值的排名：第一个 >= value 的位置（从1开始），O(log n)
+    int rank_of_value(Key value) const {
+        return std::lower_bound(sorted_values.begin(), sorted_values.end(), value)
+               - sorted_values.begin() + 1;
+    }
+
+    // 排名对应的原始值
+    Key value_of(int rank) const { return sorted_values[rank - 1]; }
+
+    // 不同值的个数
+    int size() const { return sorted_values.size(); }
+
+    const std::vector<Key>& values() const { return sorted_values; }
+    const std::vector<int>& rank_array() const { return ranks; }
+};
+
+#endif
@@ -1,8 +1,25 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <random>
+#include <cmath>
+#include "radix_discretizer.h"
 using namespace std;
 
+// 编译：g++ -O2 -std=c++17 -pthread 主席树示例代码.cpp
+// 运行：./a.out [离散化对比的元素个数]
+//   不给参数时各项性能测试用小规模，只做对拍；给出参数（如 10000000）时按完整规模运行
+
+// 批量查询：查询区间 (left_version, right_version] 中第k小元素
+struct KthQuery {
+    int left_version, right_version, k;
+};
+
 // 主席树节点结构
 struct PresidentTreeNode {
     int left_child, right_child;  // 左右子节点编号
@@ -16,7 +33,7 @@ class PresidentTree {
 private:
     vector<PresidentTreeNode> tree;  // 存储所有节点的数组
     vector<int> root;                // 每个版本的根节点编号
-    vector<int> discrete_values;     // 离散化后的值域
+    RadixDiscretizer<int> discretizer;  // 离散化（基数排序 + 每个下标的排名）
     int node_count;                  // 当前分配的节点总数
     int value_range;                 // 值域大小
     
@@ -29,32 +46,30 @@ public:
     
     // 离散化预处理
     void discretize(vector<int>& original_array) {
-        discrete_values = original_array;
-        
-        // 排序并去重，建立值域映射
-        sort(discrete_values.begin(), discrete_values.end());
-        discrete_values.erase(
-            unique(discrete_values.begin(), discrete_values.end()),
-            discrete_values.end()
-        );
-        
-        value_range = discrete_values.size();
+        // 基数排序并去重，建立值域映射
+        discretizer.build(original_array);
+        value_range = discretizer.size();
         
         cout << "离散化完成，值域大小：" << value_range << endl;
         cout << "离散化值域：";
-        for (int x : discrete_values) cout << x << " ";
+        for (int x : discretizer.values()) cout << x << " ";
         cout << endl;
     }
     
+    // 简化版离散化（无调试输出）
+    void discretize_simple(const vector<int>& original_array) {
+        discretizer.build(original_array);
+        value_range = discretizer.size();
+    }
+    
     // 获取原始值在离散化数组中的位置（从1开始）
     int get_discrete_position(int original_value) {
-        return lower_bound(discrete_values.begin(), discrete_values.end(), 
-                          original_value) - discrete_values.begin() + 1;
+        return discretizer.rank_of_value(original_value);
     }
     
     // 根据离散化位置获取原始值
-    int get_original_value(int discrete_position) {
-        return discrete_values[discrete_position - 1];
+    int get_original_value(int discrete_position) const {
+        return discretizer.value_of(discrete_position);
     }
     
     // 构建新版本：在previous_version基础上插入一个元素
@@ -77,7 +92,37 @@ public:
         cout << "新版本构建完成，版本号：" << root.size() - 1 << endl;
     }
     
+    // 简化版构建（无调试输出），节点池不足时自动扩容
+    void build_new_version_simple(int previous_version, int insert_value) {
+        append_version_simple(previous_version, get_discrete_position(insert_value));
+    }
+    
+    // 按离散化时的原数组依次构建版本1..n，
+    // 第i个元素的离散化位置直接取自排名数组，无需二分查找
+    void build_all_versions_simple() {
+        const vector<int>& ranks = discretizer.rank_array();
+        for (size_t i = 0; i < ranks.size(); i++) {
+            append_version_simple(root.size() - 1, ranks[i]);
+        }
+    }
+    
 private:
+    // 在previous_version基础上插入离散化位置discrete_pos，节点池不足时自动扩容
+    void append_version_simple(int previous_version, int discrete_pos) {
+        // 一次插入最多新建 log2(值域)+2 个节点
+        size_t need = node_count + 2;
+        for (int len = value_range; len > 1; len = (len + 1) / 2) need++;
+        if (need >= tree.size()) {
+            tree.resize(max(need + 1, tree.size() * 2));
+        }
+        
+        int new_root = create_new_version_simple(
+            root[previous_version], discrete_pos, 1, value_range
+        );
+        root.push_back(new_root);
+    }
+    
+
     // 递归构建新版本的核心函数
     int create_new_version_recursive(int previous_node, int insert_position, 
                                     int current_left, int current_right) {
@@ -133,6 +178,32 @@ private:
         return new_node;
     }
     
+    // 与 create_new_version_recursive 相同，但不输出调试信息
+    int create_new_version_simple(int previous_node, int insert_position,
+                                  int current_left, int current_right) {
+        int new_node = ++node_count;
+        tree[new_node] = tree[previous_node];
+        tree[new_node].count++;
+        
+        if (current_left == current_right) {
+            return new_node;
+        }
+        
+        int mid = (current_left + current_right) / 2;
+        if (insert_position <= mid) {
+            int child = create_new_version_simple(
+                tree[previous_node].left_child, insert_position, current_left, mid
+            );
+            tree[new_node].left_child = child;
+        } else {
+            int child = create_new_version_simple(
+                tree[previous_node].right_child, insert_position, mid + 1, current_right
+            );
+            tree[new_node].right_child = child;
+        }
+        return new_node;
+    }
+    
 public:
     // 查询区间[l,r]中的第k大元素
     int query_kth_largest(int left_version, int right_version, int k) {
@@ -227,7 +298,168 @@ public:
         return get_original_value(result_position);
     }
     
+    // 只读迭代版查询：所有版本构建完成后节点池不再修改，可被多个线程同时调用
+    int query_kth_frozen(int left_version, int right_version, int k) const {
+        int right_node = root[right_version];
+        int left_node = left_version > 0 ? root[left_version] : 0;
+        int current_left = 1, current_right = value_range;
+        
+        while (current_left < current_right) {
+            int mid = (current_left + current_right) / 2;
+            const PresidentTreeNode& rn = tree[right_node];
+            const PresidentTreeNode& ln = tree[left_node];
+            int left_half_count = tree[rn.left_child].count - tree[ln.left_child].count;
+            
+            if (k <= left_half_count) {
+                right_node = rn.left_child;
+                left_node = ln.left_child;
+                current_right = mid;
+            } else {
+                right_node = rn.right_child;
+                left_node = ln.right_child;
+                k -= left_half_count;
+                current_left = mid + 1;
+            }
+        }
+        return get_original_value(current_left);
+    }
+    
+    // 离线批量查询：按(右版本, 左版本)排序以复用相邻查询访问过的节点，
+    // 再把排好序的查询分块交给线程池执行，结果按输入顺序返回
+    vector<int> query_kth_batch(const vector<KthQuery>& queries,
+                                int thread_count = 0) const {
+        size_t q = queries.size();
+        vector<int> answers(q);
+        if (q == 0) return answers;
+        
+        // 计数排序：先按左版本、再按右版本稳定分桶，得到(右, 左)字典序
+        size_t versions = root.size();
+        vector<int> order(q), buffer(q);
+        vector<size_t> bucket(versions + 1);
+        iota(buffer.begin(), buffer.end(), 0);
+        for (int pass = 0; pass < 2; pass++) {
+            fill(bucket.begin(), bucket.end(), 0);
+            for (size_t i = 0; i < q; i++) {
+                const KthQuery& query = queries[buffer[i]];
+                bucket[(pass == 0 ? query.left_version : query.right_version) + 1]++;
+            }
+            for (size_t v = 1; v <= versions; v++) bucket[v] += bucket[v - 1];
+            for (size_t i = 0; i < q; i++) {
+                const KthQuery& query = queries[buffer[i]];
+                order[bucket[pass == 0 ? query.left_version : query.right_version]++] = buffer[i];
+            }
+            swap(order, buffer);
+        }
+        // 两轮之后排好序的结果在buffer中
+        
+        if (thread_count <= 0) {
+            thread_count = max(1u, thread::hardware_concurrency());
+        }
+        
+        // 动态分块：每个线程反复领取一段连续的已排序查询
+        const size_t CHUNK = 4096;
+        atomic<size_t> next_chunk(0);
+        auto worker = [&]() {
+            while (true) {
+                size_t begin = next_chunk.fetch_add(CHUNK);
+                if (begin >= q) break;
+                size_t end = min(q, begin + CHUNK);
+                for (size_t i = begin; i < end; i++) {
+                    const KthQuery& query = queries[buffer[i]];
+                    answers[buffer[i]] = query_kth_frozen(
+                        query.left_version, query.right_version, query.k
+                    );
+                }
+            }
+        };
+        
+        vector<thread> pool;
+        for (int t = 1; t < thread_count; t++) pool.emplace_back(worker);
+        worker();
+        for (thread& th : pool) th.join();
+        
+        return answers;
+    }
+    
+    // 区间 (left_version, right_version] 中出现次数最多的前k个值，
+    // 返回 (值, 出现次数)，按出现次数降序
+    //
+    // 最优优先搜索：节点在区间内的计数是其子树中任意一个值出现次数的上界。
+    // 按上界从大到小展开节点，叶子出堆时它的次数不小于堆中所有上界，
+    // 因此出堆的前k个叶子就是答案。只有计数不小于第k名次数的节点会被展开。
+    vector<pair<int, int>> query_top_k_frequent(int left_version, int right_version,
+                                                int k) const {
+        struct Entry {
+            int count, right_node, left_node, current_left, current_right;
+            bool operator<(const Entry& other) const { return count < other.count; }
+        };
+        
+        vector<pair<int, int>> result;
+        vector<Entry> heap;
+        int right_root = root[right_version];
+        int left_root = left_version > 0 ? root[left_version] : 0;
+        int total = tree[right_root].count - tree[left_root].count;
+        if (total > 0) heap.push_back({total, right_root, left_root, 1, value_range});
+        
+        while (!heap.empty() && (int)result.size() < k) {
+            pop_heap(heap.begin(), heap.end());
+            Entry e = heap.back();
+            heap.pop_back();
+            
+            if (e.current_left == e.current_right) {
+                result.push_back({get_original_value(e.current_left), e.count});
+                continue;
+            }
+            
+            int mid = (e.current_left + e.current_right) / 2;
+            const PresidentTreeNode& rn = tree[e.right_node];
+            const PresidentTreeNode& ln = tree[e.left_node];
+            int left_count = tree[rn.left_child].count - tree[ln.left_child].count;
+            int right_count = e.count - left_count;
+            if (left_count > 0) {
+                heap.push_back({left_count, rn.left_child, ln.left_child,
+                                e.current_left, mid});
+                push_heap(heap.begin(), heap.end());
+            }
+            if (right_count > 0) {
+                heap.push_back({right_count, rn.right_child, ln.right_child,
+                                mid + 1, e.current_right});
+                push_heap(heap.begin(), heap.end());
+            }
+        }
+        return result;
+    }
+    
+    // 区间 (left_version, right_version] 中出现次数严格大于threshold的所有值（按值升序）
+    // 计数不超过threshold的子树直接剪掉，每层最多展开 区间长度/threshold 个节点
+    vector<pair<int, int>> query_frequent_values(int left_version, int right_version,
+                                                 int threshold) const {
+        vector<pair<int, int>> result;
+        collect_frequent_recursive(root[right_version],
+                                   left_version > 0 ? root[left_version] : 0,
+                                   threshold, 1, value_range, result);
+        return result;
+    }
+    
 private:
+    void collect_frequent_recursive(int right_node, int left_node, int threshold,
+                                    int current_left, int current_right,
+                                    vector<pair<int, int>>& result) const {
+        int count = tree[right_node].count - tree[left_node].count;
+        if (count <= threshold) return;
+        
+        if (current_left == current_right) {
+            result.push_back({get_original_value(current_left), count});
+            return;
+        }
+        
+        int mid = (current_left + current_right) / 2;
+        collect_frequent_recursive(tree[right_node].left_child, tree[left_node].left_child,
+                                   threshold, current_left, mid, result);
+        collect_frequent_recursive(tree[right_node].right_child, tree[left_node].right_child,
+                                   threshold, mid + 1, current_right, result);
+    }
+    
     void print_tree_recursive(int node, int left, int right, int depth) {
         if (node == 0) return;
         
@@ -273,6 +505,82 @@ private:
     }
 };
 
+// 区间数颜色（区间内不同值的个数）
+// 以位置为下标建主席树：第r个版本中，每个值只在它于前r个元素里最后一次出现的位置计1，
+// 查询 (l, r] 时在第r个版本里统计位置 l+1..r 的和即可，支持在线回答
+class PersistentDistinctCounter {
+private:
+    vector<PresidentTreeNode> tree;
+    vector<int> root;
+    int node_count;
+    int n;
+    
+    int modify(int previous_node, int position, int delta,
+               int current_left, int current_right) {
+        int new_node = ++node_count;
+        tree[new_node] = tree[previous_node];
+        tree[new_node].count += delta;
+        
+        if (current_left == current_right) return new_node;
+        
+        int mid = (current_left + current_right) / 2;
+        if (position <= mid) {
+            int child = modify(tree[previous_node].left_child, position, delta,
+                               current_left, mid);
+            tree[new_node].left_child = child;
+        } else {
+            int child = modify(tree[previous_node].right_child, position, delta,
+                               mid + 1, current_right);
+            tree[new_node].right_child = child;
+        }
+        return new_node;
+    }
+    
+public:
+    explicit PersistentDistinctCounter(const vector<int>& original_array)
+        : node_count(0), n(original_array.size()) {
+        RadixDiscretizer<int> discretizer(original_array);
+        
+        // 每个版本最多两条路径：当前位置+1，上一次出现的位置-1
+        int depth = 2;
+        for (int len = n; len > 1; len = (len + 1) / 2) depth++;
+        tree.resize((size_t)n * depth * 2 + 1);
+        
+        vector<int> last(discretizer.size() + 1, 0);
+        root.push_back(0);
+        for (int i = 1; i <= n; i++) {
+            int rank = discretizer.rank_at(i - 1);
+            int current = modify(root.back(), i, 1, 1, n);
+            if (last[rank]) current = modify(current, last[rank], -1, 1, n);
+            last[rank] = i;
+            root.push_back(current);
+        }
+    }
+    
+    // 区间 (left_version, right_version] 中不同值的个数
+    int query_distinct(int left_version, int right_version) const {
+        int node = root[right_version];
+        int current_left = 1, current_right = n;
+        int low = left_version + 1;
+        int result = 0;
+        
+        // 统计版本right_version中位置 >= low 的计数
+        while (node && current_left < current_right) {
+            int mid = (current_left + current_right) / 2;
+            if (low <= mid) {
+                result += tree[tree[node].right_child].count;
+                node = tree[node].left_child;
+                current_right = mid;
+            } else {
+                node = tree[node].right_child;
+                current_left = mid + 1;
+            }
+        }
+        if (node && current_left >= low) result += tree[node].count;
+        return result;
+    }
+};
+
 // 使用示例和测试函数
 void demonstrate_president_tree() {
     cout << "=== 主席树演示程序 ===" << endl;
@@ -342,12 +650,196 @@ void performance_test() {
     }
 }
 
-int main() {
+// 批量查询测试：逐个查询与多线程批量查询对比（q 个查询）
+void batch_query_test(int q) {
+    cout << "\n=== 批量查询测试 ===" << endl;
+    
+    const int n = 200000;
+    
+    srand(2024);
+    vector<int> arr(n);
+    for (int i = 0; i < n; i++) {
+        arr[i] = rand() % 1000000000;
+    }
+    
+    PresidentTree pt;
+    pt.discretize_simple(arr);
+    pt.build_all_versions_simple();
+    
+    vector<KthQuery> queries(q);
+    for (int i = 0; i < q; i++) {
+        int l = rand() % n;
+        int r = l + 1 + rand() % (n - l);
+        int k = rand() % (r - l) + 1;
+        queries[i] = {l, r, k};
+    }
+    
+    auto start = chrono::high_resolution_clock::now();
+    vector<int> expected(q);
+    for (int i = 0; i < q; i++) {
+        expected[i] = pt.query_kth_simple(
+            queries[i].left_version, queries[i].right_version, queries[i].k
+        );
+    }
+    auto mid = chrono::high_resolution_clock::now();
+    vector<int> answers = pt.query_kth_batch(queries);
+    auto end = chrono::high_resolution_clock::now();
+    
+    auto serial_ms = chrono::duration_cast<chrono::milliseconds>(mid - start).count();
+    auto batch_ms = chrono::duration_cast<chrono::milliseconds>(end - mid).count();
+    
+    cout << "数组大小：" << n << "，查询数：" << q
+         << "，线程数：" << max(1u, thread::hardware_concurrency()) << endl;
+    cout << "逐个查询：" << serial_ms << " ms" << endl;
+    cout << "批量查询：" << batch_ms << " ms" << endl;
+    cout << "结果一致：" << (answers == expected ? "是" : "否") << endl;
+}
+
+// 离散化对比：sort + unique + lower_bound 与 基数排序 + 排名数组
+void discretize_benchmark(int n) {
+    cout << "\n=== 离散化对比 ===" << endl;
+    
+    mt19937 rng(7);
+    uniform_int_distribution<int> value(-500000000, 500000000);
+    vector<int> arr(n);
+    for (int i = 0; i < n; i++) {
+        arr[i] = value(rng);
+    }
+    
+    auto start = chrono::high_resolution_clock::now();
+    vector<int> values = arr;
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+    vector<int> expected(n);
+    for (int i = 0; i < n; i++) {
+        expected[i] = lower_bound(values.begin(), values.end(), arr[i]) - values.begin() + 1;
+    }
+    auto mid = chrono::high_resolution_clock::now();
+    RadixDiscretizer<int> discretizer(arr);
+    auto end = chrono::high_resolution_clock::now();
+    
+    cout << "元素个数：" << n << "，不同值个数：" << discretizer.size() << endl;
+    cout << "sort + lower_bound：" 
+         << chrono::duration_cast<chrono::milliseconds>(mid - start).count() << " ms" << endl;
+    cout << "基数排序 + 排名数组：" 
+         << chrono::duration_cast<chrono::milliseconds>(end - mid).count() << " ms" << endl;
+    cout << "结果一致：" << (discretizer.rank_array() == expected ? "是" : "否") << endl;
+}
+
+// 区间数颜色与区间高频值测试
+void range_statistics_test(bool full) {
+    cout << "\n=== 区间数颜色 / 区间高频值测试 ===" << endl;
+    
+    // 小规模暴力对拍
+    srand(11);
+    bool ok = true;
+    for (int round = 0; round < 100 && ok; round++) {
+        int n = rand() % 40 + 1;
+        vector<int> arr(n);
+        for (int& x : arr) x = rand() % 8;
+        
+        PresidentTree pt;
+        pt.discretize_simple(arr);
+        pt.build_all_versions_simple();
+        PersistentDistinctCounter dc(arr);
+        
+        for (int l = 0; l < n && ok; l++) {
+            for (int r = l + 1; r <= n && ok; r++) {
+                map<int, int> freq;
+                for (int i = l; i < r; i++) freq[arr[i]]++;
+                
+                vector<pair<int, int>> top = pt.query_top_k_frequent(l, r, 3);
+                vector<int> counts;
+                for (auto& entry : freq) counts.push_back(entry.second);
+                sort(counts.rbegin(), counts.rend());
+                
+                ok = dc.query_distinct(l, r) == (int)freq.size()
+                  && top.size() == min<size_t>(3, freq.size());
+                for (size_t i = 0; i < top.size() && ok; i++) {
+                    ok = top[i].second == counts[i] && freq[top[i].first] == top[i].second;
+                }
+                
+                vector<pair<int, int>> heavy = pt.query_frequent_values(l, r, (r - l) / 3);
+                int expected_heavy = 0;
+                for (auto& entry : freq) expected_heavy += entry.second > (r - l) / 3;
+                ok = ok && (int)heavy.size() == expected_heavy;
+            }
+        }
+    }
+    cout << "暴力对拍：" << (ok ? "✓ 全部一致" : "✗ 发现不一致") << endl;
+    
+    // 完整规模：10^6 个元素，10^6 次数颜色查询；值服从长尾分布（少数值出现很多次）
+    // 前k高频值查询的代价与区间内“计数不小于第k名次数”的节点数成正比，
+    // 长区间上每次约需展开上千个节点，这里只取前 10^5 个查询计时；默认规模各缩小 10 倍
+    const int n = full ? 1000000 : 100000;
+    const int q = n;
+    const int top_q = n / 10;
+    const int top_k = 10;
+    mt19937 rng(2024);
+    vector<int> arr(n);
+    for (int& x : arr) {
+        double u = (rng() + 1.0) / 4294967296.0;
+        x = (int)(100000 * pow(u, 3.0));
+    }
+    vector<KthQuery> queries(q);
+    for (KthQuery& query : queries) {
+        int l = rng() % n;
+        int r = l + 1 + rng() % (n - l);
+        query = {l, r, top_k};
+    }
+    
+    auto t0 = chrono::high_resolution_clock::now();
+    PersistentDistinctCounter dc(arr);
+    auto t1 = chrono::high_resolution_clock::now();
+    long long distinct_sum = 0;
+    for (const KthQuery& query : queries) {
+        distinct_sum += dc.query_distinct(query.left_version, query.right_version);
+    }
+    auto t2 = chrono::high_resolution_clock::now();
+    
+    PresidentTree pt;
+    pt.discretize_simple(arr);
+    pt.build_all_versions_simple();
+    auto t3 = chrono::high_resolution_clock::now();
+    long long top_sum = 0;
+    for (int i = 0; i < top_q; i++) {
+        vector<pair<int, int>> top = pt.query_top_k_frequent(
+            queries[i].left_version, queries[i].right_version, queries[i].k
+        );
+        top_sum += top[0].second;
+    }
+    auto t4 = chrono::high_resolution_clock::now();
+    
+    cout << "元素个数：" << n << endl;
+    cout << "区间数颜色：构建 " 
+         << chrono::duration_cast<chrono::milliseconds>(t1 - t0).count() << " ms，"
+         << q << " 次查询 "
+         << chrono::duration_cast<chrono::milliseconds>(t2 - t1).count() << " ms"
+         << "（平均不同值个数 " << distinct_sum / q << "）" << endl;
+    cout << "区间前" << top_k << "高频值：构建 "
+         << chrono::duration_cast<chrono::milliseconds>(t3 - t2).count() << " ms，"
+         << top_q << " 次查询 "
+         << chrono::duration_cast<chrono::milliseconds>(t4 - t3).count() << " ms"
+         << "（平均最高频次 " << top_sum / top_q << "）" << endl;
+}
+
+int main(int argc, char* argv[]) {
     // 详细演示
     demonstrate_president_tree();
     
     // 性能测试
     performance_test();
     
+    bool full = argc > 1;
+    
+    // 批量查询测试
+    batch_query_test(full ? 2000000 : 200000);
+    
+    // 离散化对比
+    discretize_benchmark(full ? atoi(argv[1]) : 100000);
+    
+    // 区间数颜色与区间高频值
+    range_statistics_test(full);
+    
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,396 @@
+/*
+ * 小波矩阵（Wavelet Matrix）
+ * 千禧年科技学院 - 静态区间第k小 / 区间计数 / 区间排名
+ *
+ * 与主席树的对比：
+ * - 主席树：每次插入新建 O(log n) 个节点，共 O(n log n) 个节点，
+ *           查询时每一层都要跳到一个随机位置的节点
+ * - 小波矩阵：共 ⌈log σ⌉ 层位向量，每层 n 个比特，总空间约 n·log σ 比特；
+ *           每层只需两次 rank 查询，rank 由分块前缀和 + popcount 完成
+ *
+ * 接口与 PresidentTree 保持一致：
+ *   query_kth_simple(l, r, k) 返回原数组第 l+1..r 个元素中第k小的值
+ *
+ * 时间复杂度：构建 O(n log σ)，单次查询 O(log σ)
+ * 空间复杂度：O(n log σ) 比特
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 -mpopcnt 小波矩阵示例代码.cpp -o wm
+ *   ./wm            # 默认 n = 10^6
+ *   ./wm 10000000   # 10^7 对比测试（主席树部分约需 3GB 内存）
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// 支持 rank 的位向量：每 256 比特一个块，块内存放前缀 1 的个数
+class RankBitVector {
+private:
+    struct Block {
+        uint64_t rank;       // 块之前 1 的个数
+        uint64_t words[4];   // 256 个比特
+    };
+    vector<Block> blocks;
+    size_t length;
+
+public:
+    RankBitVector() : length(0) {}
+
+    explicit RankBitVector(size_t n) : blocks(n / 256 + 1), length(n) {
+        memset(blocks.data(), 0, blocks.size() * sizeof(Block));
+    }
+
+    void set(size_t i) {
+        blocks[i >> 8].words[(i >> 6) & 3] |= 1ULL << (i & 63);
+    }
+
+    bool get(size_t i) const {
+        return blocks[i >> 8].words[(i >> 6) & 3] >> (i & 63) & 1;
+    }
+
+    // 设置完所有比特后调用，计算每个块的前缀和
+    void build() {
+        uint64_t sum = 0;
+        for (Block& b : blocks) {
+            b.rank = sum;
+            for (int w = 0; w < 4; w++) sum += __builtin_popcountll(b.words[w]);
+        }
+    }
+
+    // [0, i) 中 1 的个数
+    size_t rank1(size_t i) const {
+        const Block& b = blocks[i >> 8];
+        size_t res = b.rank;
+        int w = (i >> 6) & 3;
+        for (int j = 0; j < w; j++) res += __builtin_popcountll(b.words[j]);
+        if (i & 63) res += __builtin_popcountll(b.words[w] << (64 - (i & 63)));
+        return res;
+    }
+
+    // [0, i) 中 0 的个数
+    size_t rank0(size_t i) const { return i - rank1(i); }
+
+    size_t size() const { return length; }
+};
+
+class WaveletMatrix {
+private:
+    vector<RankBitVector> levels;   // levels[0] 对应最高位
+    vector<size_t> zero_count;      // 每层 0 的个数
+    vector<int> discrete_values;    // 离散化后的值域
+    int bit_count;                  // 层数 ⌈log σ⌉
+    size_t n;
+
+public:
+    WaveletMatrix() : bit_count(0), n(0) {}
+
+    explicit WaveletMatrix(const vector<int>& original_array) {
+        build(original_array);
+    }
+
+    void build(const vector<int>& original_array) {
+        n = original_array.size();
+
+        discrete_values = original_array;
+        sort(discrete_values.begin(), discrete_values.end());
+        discrete_values.erase(
+            unique(discrete_values.begin(), discrete_values.end()),
+            discrete_values.end()
+        );
+
+        // 离散化为 [0, σ) 的排名
+        vector<uint32_t> cur(n), nxt(n);
+        for (size_t i = 0; i < n; i++) {
+            cur[i] = lower_bound(discrete_values.begin(), discrete_values.end(),
+                                 original_array[i]) - discrete_values.begin();
+        }
+
+        bit_count = 1;
+        while ((1ULL << bit_count) < discrete_values.size()) bit_count++;
+
+        levels.assign(bit_count, RankBitVector());
+        zero_count.assign(bit_count, 0);
+
+        // 自顶向下：每层按当前位稳定划分，0 在前 1 在后
+        for (int level = 0; level < bit_count; level++) {
+            int bit = bit_count - 1 - level;
+            RankBitVector bv(n);
+            size_t zeros = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (cur[i] >> bit & 1) bv.set(i);
+                else zeros++;
+            }
+            bv.build();
+
+            size_t zi = 0, oi = zeros;
+            for (size_t i = 0; i < n; i++) {
+                if (cur[i] >> bit & 1) nxt[oi++] = cur[i];
+                else nxt[zi++] = cur[i];
+            }
+            swap(cur, nxt);
+
+            levels[level] = move(bv);
+            zero_count[level] = zeros;
+        }
+    }
+
+    // 与 PresidentTree::query_kth_simple 相同：区间 (l, r] 中第k小（k从1开始）
+    int query_kth_simple(int left_version, int right_version, int k) const {
+        size_t l = left_version, r = right_version;
+        uint32_t result = 0;
+
+        for (int level = 0; level < bit_count; level++) {
+            const RankBitVector& bv = levels[level];
+            size_t l0 = bv.rank0(l), r0 = bv.rank0(r);
+            size_t zeros = r0 - l0;
+
+            if ((size_t)k <= zeros) {
+                l = l0;
+                r = r0;
+            } else {
+                k -= zeros;
+                l = zero_count[level] + (l - l0);
+                r = zero_count[level] + (r - r0);
+                result |= 1u << (bit_count - 1 - level);
+            }
+        }
+        return discrete_values[result];
+    }
+
+    // 区间 (l, r] 中严格小于 value 的元素个数
+    int range_rank(int left_version, int right_version, int value) const {
+        uint32_t x = lower_bound(discrete_values.begin(), discrete_values.end(),
+                                 value) - discrete_values.begin();
+        if (x >= discrete_values.size()) return right_version - left_version;
+
+        size_t l = left_version, r = right_version;
+        int result = 0;
+        for (int level = 0; level < bit_count; level++) {
+            const RankBitVector& bv = levels[level];
+            size_t l0 = bv.rank0(l), r0 = bv.rank0(r);
+
+            if (x >> (bit_count - 1 - level) & 1) {
+                result += r0 - l0;   // 当前位为0的元素都更小
+                l = zero_count[level] + (l - l0);
+                r = zero_count[level] + (r - r0);
+            } else {
+                l = l0;
+                r = r0;
+            }
+        }
+        return result;
+    }
+
+    // 区间 (l, r] 中值落在 [low, high] 的元素个数
+    int range_count(int left_version, int right_version, int low, int high) const {
+        if (low > high) return 0;
+        int upper = (high == INT_MAX) ? right_version - left_version
+                                      : range_rank(left_version, right_version, high + 1);
+        return upper - range_rank(left_version, right_version, low);
+    }
+
+    // 占用的字节数
+    size_t memory_bytes() const {
+        size_t bytes = discrete_values.size() * sizeof(int);
+        for (const RankBitVector& bv : levels) bytes += (bv.size() / 256 + 1) * 40;
+        return bytes;
+    }
+};
+
+// =============================================================================
+// 对比用：与 主席树示例代码.cpp 结构相同的主席树（去掉调试输出）
+// =============================================================================
+
+class PresidentTree {
+private:
+    struct Node { int left_child, right_child, count; };
+    vector<Node> tree;
+    vector<int> root;
+    vector<int> discrete_values;
+    int node_count;
+    int value_range;
+
+    int insert(int previous_node, int pos, int current_left, int current_right) {
+        int new_node = ++node_count;
+        tree[new_node] = tree[previous_node];
+        tree[new_node].count++;
+        if (current_left == current_right) return new_node;
+
+        int mid = (current_left + current_right) / 2;
+        if (pos <= mid) {
+            int child = insert(tree[previous_node].left_child, pos, current_left, mid);
+            tree[new_node].left_child = child;
+        } else {
+            int child = insert(tree[previous_node].right_child, pos, mid + 1, current_right);
+            tree[new_node].right_child = child;
+        }
+        return new_node;
+    }
+
+public:
+    explicit PresidentTree(const vector<int>& original_array) : node_count(0) {
+        discrete_values = original_array;
+        sort(discrete_values.begin(), discrete_values.end());
+        discrete_values.erase(
+            unique(discrete_values.begin(), discrete_values.end()),
+            discrete_values.end()
+        );
+        value_range = discrete_values.size();
+
+        int depth = 2;
+        for (int len = value_range; len > 1; len = (len + 1) / 2) depth++;
+        tree.assign(original_array.size() * depth + 1, Node{0, 0, 0});
+
+        root.push_back(0);
+        for (int x : original_array) {
+            int pos = lower_bound(discrete_values.begin(), discrete_values.end(), x)
+                      - discrete_values.begin() + 1;
+            root.push_back(insert(root.back(), pos, 1, value_range));
+        }
+    }
+
+    int query_kth_simple(int left_version, int right_version, int k) const {
+        int right_node = root[right_version];
+        int left_node = root[left_version];
+        int current_left = 1, current_right = value_range;
+        while (current_left < current_right) {
+            int mid = (current_left + current_right) / 2;
+            int left_half_count = tree[tree[right_node].left_child].count
+                                - tree[tree[left_node].left_child].count;
+            if (k <= left_half_count) {
+                right_node = tree[right_node].left_child;
+                left_node = tree[left_node].left_child;
+                current_right = mid;
+            } else {
+                right_node = tree[right_node].right_child;
+                left_node = tree[left_node].right_child;
+                k -= left_half_count;
+                current_left = mid + 1;
+            }
+        }
+        return discrete_values[current_left - 1];
+    }
+
+    size_t memory_bytes() const {
+        return (size_t)(node_count + 1) * sizeof(Node)
+             + root.size() * sizeof(int)
+             + discrete_values.size() * sizeof(int);
+    }
+};
+
+// =============================================================================
+// 测试与对比
+// =============================================================================
+
+void demonstrate_wavelet_matrix() {
+    cout << "=== 小波矩阵演示 ===" << endl;
+
+    vector<int> arr = {3, 1, 4, 1, 5, 9, 2, 6};
+    WaveletMatrix wm(arr);
+
+    cout << "原始数组：";
+    for (int x : arr) cout << x << " ";
+    cout << endl;
+
+    cout << "区间[2,5]中第2小：" << wm.query_kth_simple(1, 5, 2) << endl;
+    cout << "区间[1,4]中第1小：" << wm.query_kth_simple(0, 4, 1) << endl;
+    cout << "区间[3,7]中第3小：" << wm.query_kth_simple(2, 7, 3) << endl;
+    cout << "区间[1,8]中小于5的个数：" << wm.range_rank(0, 8, 5) << endl;
+    cout << "区间[1,8]中值在[2,6]的个数：" << wm.range_count(0, 8, 2, 6) << endl;
+    cout << endl;
+}
+
+// 小规模暴力对拍
+void verify_against_brute_force() {
+    cout << "=== 暴力对拍 ===" << endl;
+
+    mt19937 rng(42);
+    bool ok = true;
+    for (int round = 0; round < 200 && ok; round++) {
+        int n = rng() % 60 + 1;
+        vector<int> arr(n);
+        for (int& x : arr) x = (int)(rng() % 41) - 20;
+
+        WaveletMatrix wm(arr);
+        PresidentTree pt(arr);
+
+        for (int l = 0; l < n && ok; l++) {
+            for (int r = l + 1; r <= n && ok; r++) {
+                vector<int> sorted_part(arr.begin() + l, arr.begin() + r);
+                sort(sorted_part.begin(), sorted_part.end());
+
+                int k = rng() % (r - l) + 1;
+                int value = (int)(rng() % 45) - 22;
+                int less = lower_bound(sorted_part.begin(), sorted_part.end(), value)
+                           - sorted_part.begin();
+
+                ok = wm.query_kth_simple(l, r, k) == sorted_part[k - 1]
+                  && pt.query_kth_simple(l, r, k) == sorted_part[k - 1]
+                  && wm.range_rank(l, r, value) == less;
+            }
+        }
+    }
+    cout << (ok ? "✓ 200 组随机数据全部一致" : "✗ 发现不一致") << endl;
+    cout << endl;
+}
+
+// 主席树 vs 小波矩阵
+void performance_compare(int n) {
+    cout << "=== 性能对比：n = " << n << " ===" << endl;
+
+    mt19937 rng(2024);
+    vector<int> arr(n);
+    for (int& x : arr) x = rng() % 1000000000;
+
+    const int q = 1000000;
+    vector<array<int, 3>> queries(q);
+    for (auto& query : queries) {
+        int l = rng() % n;
+        int r = l + 1 + rng() % (n - l);
+        int k = rng() % (r - l) + 1;
+        query = {l, r, k};
+    }
+
+    auto t0 = chrono::high_resolution_clock::now();
+    WaveletMatrix wm(arr);
+    auto t1 = chrono::high_resolution_clock::now();
+    long long wm_checksum = 0;
+    for (auto& query : queries) {
+        wm_checksum += wm.query_kth_simple(query[0], query[1], query[2]);
+    }
+    auto t2 = chrono::high_resolution_clock::now();
+
+    cout << "小波矩阵：构建 "
+         << chrono::duration_cast<chrono::milliseconds>(t1 - t0).count() << " ms，"
+         << q << " 次查询 "
+         << chrono::duration_cast<chrono::milliseconds>(t2 - t1).count() << " ms，"
+         << "内存 " << wm.memory_bytes() / (1 << 20) << " MB" << endl;
+
+    auto t3 = chrono::high_resolution_clock::now();
+    PresidentTree pt(arr);
+    auto t4 = chrono::high_resolution_clock::now();
+    long long pt_checksum = 0;
+    for (auto& query : queries) {
+        pt_checksum += pt.query_kth_simple(query[0], query[1], query[2]);
+    }
+    auto t5 = chrono::high_resolution_clock::now();
+
+    cout << "主席树：  构建 "
+         << chrono::duration_cast<chrono::milliseconds>(t4 - t3).count() << " ms，"
+         << q << " 次查询 "
+         << chrono::duration_cast<chrono::milliseconds>(t5 - t4).count() << " ms，"
+         << "内存 " << pt.memory_bytes() / (1 << 20) << " MB" << endl;
+
+    cout << "结果一致：" << (wm_checksum == pt_checksum ? "是" : "否") << endl;
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    demonstrate_wavelet_matrix();
+    verify_against_brute_force();
+    performance_compare(n);
+
+    return 0;
+}
@@ -0,0 +1,442 @@
+/*
+ * 带修改的区间第k小（Dynamic Rankings）
+ * 千禧年科技学院 - 主席树进阶专题
+ *
+ * 问题：长度为 n 的序列，支持
+ *   update(pos, value)  把第 pos 个元素改为 value
+ *   kth(l, r, k)        查询第 l..r 个元素中第k小（位置、k 都从1开始）
+ *
+ * 普通主席树的第 i 个版本依赖前 i-1 个版本，修改第 pos 个元素后
+ * 第 pos..n 个版本全部失效，只能重建。本文件给出两种 polylog 做法：
+ *
+ * 1. 树状数组套动态开点权值线段树（在线）
+ *    树状数组第 i 个位置维护 (i - lowbit(i), i] 内元素的权值线段树，
+ *    修改 / 查询都涉及 O(log n) 棵线段树，每棵走 O(log V) 层。
+ *    时间：O(log n · log V) / 操作，空间：O((n + q) log n log V)
+ *
+ * 2. 整体二分（离线）
+ *    把初始元素、修改（拆成删除旧值 + 插入新值）和查询按时间顺序排好，
+ *    对值域二分，每层用一个树状数组按时间顺序扫描，把操作分到左右两半。
+ *    时间：O((n + q) log n log V)，空间：O(n + q)
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 带修改区间第k小.cpp -o dynamic_kth
+ *   ./dynamic_kth [n] [操作数]
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// =============================================================================
+// 做法一：树状数组套动态开点权值线段树（在线）
+// =============================================================================
+
+class BITOfSegmentTrees {
+private:
+    struct Node {
+        int left_child, right_child, count;
+    };
+
+    int n;
+    int value_low, value_high;   // 值域 [value_low, value_high]
+    vector<Node> tree;           // 节点池，0号为空节点
+    vector<int> root;            // 树状数组每个位置对应的线段树根
+    vector<int> values;          // 当前序列（下标从1开始）
+
+    // 查询时暂存参与计算的根节点
+    vector<int> plus_nodes, minus_nodes;
+
+    int new_node() {
+        tree.push_back(Node{0, 0, 0});
+        return tree.size() - 1;
+    }
+
+    // 在以 node 为根的线段树中把 value 的计数加上 delta
+    void modify(int& node, int value, int delta) {
+        if (!node) node = new_node();
+        int current = node;
+        long long lo = value_low, hi = value_high;
+        while (true) {
+            tree[current].count += delta;
+            if (lo == hi) break;
+            long long mid = (lo + hi) >> 1;
+            if (value <= mid) {
+                if (!tree[current].left_child) {
+                    int child = new_node();
+                    tree[current].left_child = child;
+                }
+                current = tree[current].left_child;
+                hi = mid;
+            } else {
+                if (!tree[current].right_child) {
+                    int child = new_node();
+                    tree[current].right_child = child;
+                }
+                current = tree[current].right_child;
+                lo = mid + 1;
+            }
+        }
+    }
+
+    void bit_add(int pos, int value, int delta) {
+        for (int i = pos; i <= n; i += i & -i) {
+            modify(root[i], value, delta);
+        }
+    }
+
+public:
+    BITOfSegmentTrees(const vector<int>& initial, int value_low, int value_high)
+        : n(initial.size()), value_low(value_low), value_high(value_high) {
+        tree.reserve(initial.size() * 64);
+        tree.push_back(Node{0, 0, 0});
+        root.assign(n + 1, 0);
+        values.assign(n + 1, 0);
+        for (int i = 1; i <= n; i++) {
+            values[i] = initial[i - 1];
+            bit_add(i, values[i], 1);
+        }
+    }
+
+    void update(int pos, int value) {
+        if (values[pos] == value) return;
+        bit_add(pos, values[pos], -1);
+        values[pos] = value;
+        bit_add(pos, value, 1);
+    }
+
+    int kth(int l, int r, int k) {
+        plus_nodes.clear();
+        minus_nodes.clear();
+        for (int i = r; i > 0; i -= i & -i) plus_nodes.push_back(root[i]);
+        for (int i = l - 1; i > 0; i -= i & -i) minus_nodes.push_back(root[i]);
+
+        long long lo = value_low, hi = value_high;
+        while (lo < hi) {
+            long long mid = (lo + hi) >> 1;
+            int left_half_count = 0;
+            for (int node : plus_nodes) left_half_count += tree[tree[node].left_child].count;
+            for (int node : minus_nodes) left_half_count -= tree[tree[node].left_child].count;
+
+            bool go_left = k <= left_half_count;
+            if (!go_left) k -= left_half_count;
+            for (int& node : plus_nodes) {
+                node = go_left ? tree[node].left_child : tree[node].right_child;
+            }
+            for (int& node : minus_nodes) {
+                node = go_left ? tree[node].left_child : tree[node].right_child;
+            }
+            if (go_left) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    size_t node_count() const { return tree.size(); }
+};
+
+// =============================================================================
+// 做法二：整体二分（离线批处理）
+// =============================================================================
+
+struct Operation {
+    int type;        // 0：查询 (l, r, k)；1：修改 (pos, value)
+    int a, b, c;     // 查询：l, r, k；修改：pos, value, 未使用
+};
+
+class OverallBinarySearch {
+private:
+    struct Event {
+        int type;        // 0：查询；1：在 pos 处给值 value 计数 +sign
+        int pos, value, sign;
+        int l, r, k, id;
+    };
+
+    vector<Event> events, left_buffer, right_buffer;
+    vector<int> bit;
+    vector<int> answers;
+    int n;
+
+    void bit_add(int pos, int delta) {
+        for (int i = pos; i <= n; i += i & -i) bit[i] += delta;
+    }
+
+    int bit_sum(int pos) {
+        int res = 0;
+        for (int i = pos; i > 0; i -= i & -i) res += bit[i];
+        return res;
+    }
+
+    // 处理 events[ql, qr)，答案在值域 [lo, hi] 内
+    void solve(long long lo, long long hi, int ql, int qr) {
+        if (ql >= qr) return;
+        if (lo == hi) {
+            for (int i = ql; i < qr; i++) {
+                if (events[i].type == 0) answers[events[i].id] = lo;
+            }
+            return;
+        }
+
+        long long mid = (lo + hi) >> 1;
+        left_buffer.clear();
+        right_buffer.clear();
+
+        for (int i = ql; i < qr; i++) {
+            Event& e = events[i];
+            if (e.type == 1) {
+                if (e.value <= mid) {
+                    bit_add(e.pos, e.sign);
+                    left_buffer.push_back(e);
+                } else {
+                    right_buffer.push_back(e);
+                }
+            } else {
+                int count = bit_sum(e.r) - bit_sum(e.l - 1);
+                if (e.k <= count) {
+                    left_buffer.push_back(e);
+                } else {
+                    e.k -= count;
+                    right_buffer.push_back(e);
+                }
+            }
+        }
+
+        // 撤销本层对树状数组的修改
+        for (const Event& e : left_buffer) {
+            if (e.type == 1) bit_add(e.pos, -e.sign);
+        }
+
+        int split = ql + left_buffer.size();
+        copy(left_buffer.begin(), left_buffer.end(), events.begin() + ql);
+        copy(right_buffer.begin(), right_buffer.end(), events.begin() + split);
+
+        solve(lo, mid, ql, split);
+        solve(mid + 1, hi, split, qr);
+    }
+
+public:
+    // 返回所有查询的答案（按查询出现的顺序）
+    vector<int> run(const vector<int>& initial, const vector<Operation>& operations,
+                    int value_low, int value_high) {
+        n = initial.size();
+        events.clear();
+
+        vector<int> current(initial.begin(), initial.end());
+        for (int i = 0; i < n; i++) {
+            events.push_back(Event{1, i + 1, initial[i], 1, 0, 0, 0, 0});
+        }
+
+        int query_count = 0;
+        for (const Operation& op : operations) {
+            if (op.type == 1) {
+                int pos = op.a;
+                events.push_back(Event{1, pos, current[pos - 1], -1, 0, 0, 0, 0});
+                events.push_back(Event{1, pos, op.b, 1, 0, 0, 0, 0});
+                current[pos - 1] = op.b;
+            } else {
+                events.push_back(Event{0, 0, 0, 0, op.a, op.b, op.c, query_count++});
+            }
+        }
+
+        bit.assign(n + 1, 0);
+        answers.assign(query_count, 0);
+        solve(value_low, value_high, 0, events.size());
+        return answers;
+    }
+};
+
+// =============================================================================
+// 对比基准：每次修改后整体重建主席树
+// =============================================================================
+
+class RebuildPresidentTree {
+private:
+    struct Node { int left_child, right_child, count; };
+    vector<Node> tree;
+    vector<int> root;
+    vector<int> discrete_values;
+    vector<int> values;
+    int node_count;
+    int value_range;
+
+    int insert(int previous_node, int pos, int current_left, int current_right) {
+        int new_node = ++node_count;
+        tree[new_node] = tree[previous_node];
+        tree[new_node].count++;
+        if (current_left == current_right) return new_node;
+
+        int mid = (current_left + current_right) / 2;
+        if (pos <= mid) {
+            int child = insert(tree[previous_node].left_child, pos, current_left, mid);
+            tree[new_node].left_child = child;
+        } else {
+            int child = insert(tree[previous_node].right_child, pos, mid + 1, current_right);
+            tree[new_node].right_child = child;
+        }
+        return new_node;
+    }
+
+    void rebuild() {
+        discrete_values = values;
+        sort(discrete_values.begin(), discrete_values.end());
+        discrete_values.erase(
+            unique(discrete_values.begin(), discrete_values.end()),
+            discrete_values.end()
+        );
+        value_range = discrete_values.size();
+
+        int depth = 2;
+        for (int len = value_range; len > 1; len = (len + 1) / 2) depth++;
+        tree.assign(values.size() * depth + 1, Node{0, 0, 0});
+        node_count = 0;
+
+        root.assign(1, 0);
+        for (int x : values) {
+            int pos = lower_bound(discrete_values.begin(), discrete_values.end(), x)
+                      - discrete_values.begin() + 1;
+            root.push_back(insert(root.back(), pos, 1, value_range));
+        }
+    }
+
+public:
+    explicit RebuildPresidentTree(const vector<int>& initial) : values(initial) {
+        rebuild();
+    }
+
+    void update(int pos, int value) {
+        values[pos - 1] = value;
+        rebuild();
+    }
+
+    int kth(int l, int r, int k) const {
+        int right_node = root[r], left_node = root[l - 1];
+        int current_left = 1, current_right = value_range;
+        while (current_left < current_right) {
+            int mid = (current_left + current_right) / 2;
+            int left_half_count = tree[tree[right_node].left_child].count
+                                - tree[tree[left_node].left_child].count;
+            if (k <= left_half_count) {
+                right_node = tree[right_node].left_child;
+                left_node = tree[left_node].left_child;
+                current_right = mid;
+            } else {
+                right_node = tree[right_node].right_child;
+                left_node = tree[left_node].right_child;
+                k -= left_half_count;
+                current_left = mid + 1;
+            }
+        }
+        return discrete_values[current_left - 1];
+    }
+};
+
+// =============================================================================
+// 测试
+// =============================================================================
+
+vector<Operation> random_operations(int n, int count, int value_high, mt19937& rng) {
+    vector<Operation> operations(count);
+    for (Operation& op : operations) {
+        if (rng() % 2) {
+            op = {1, (int)(rng() % n) + 1, (int)(rng() % (value_high + 1)), 0};
+        } else {
+            int l = rng() % n + 1;
+            int r = l + rng() % (n - l + 1);
+            int k = rng() % (r - l + 1) + 1;
+            op = {0, l, r, k};
+        }
+    }
+    return operations;
+}
+
+void verify_against_brute_force() {
+    cout << "=== 暴力对拍 ===" << endl;
+
+    mt19937 rng(7);
+    bool ok = true;
+    for (int round = 0; round < 300 && ok; round++) {
+        int n = rng() % 30 + 1;
+        int value_high = rng() % 50;
+        vector<int> initial(n);
+        for (int& x : initial) x = rng() % (value_high + 1);
+        vector<Operation> operations = random_operations(n, 60, value_high, rng);
+
+        BITOfSegmentTrees online(initial, 0, value_high);
+        vector<int> offline = OverallBinarySearch().run(initial, operations, 0, value_high);
+
+        vector<int> brute = initial;
+        int query_id = 0;
+        for (const Operation& op : operations) {
+            if (op.type == 1) {
+                brute[op.a - 1] = op.b;
+                online.update(op.a, op.b);
+            } else {
+                vector<int> part(brute.begin() + op.a - 1, brute.begin() + op.b);
+                nth_element(part.begin(), part.begin() + op.c - 1, part.end());
+                int expected = part[op.c - 1];
+                ok = ok && online.kth(op.a, op.b, op.c) == expected
+                        && offline[query_id] == expected;
+                query_id++;
+            }
+        }
+    }
+    cout << (ok ? "✓ 在线 / 离线结果与暴力一致" : "✗ 发现不一致") << endl;
+    cout << endl;
+}
+
+void performance_test(int n, int op_count) {
+    cout << "=== 性能测试：n = " << n << "，操作数 = " << op_count << " ===" << endl;
+
+    const int value_high = 1000000;
+    mt19937 rng(2024);
+    vector<int> initial(n);
+    for (int& x : initial) x = rng() % (value_high + 1);
+    vector<Operation> operations = random_operations(n, op_count, value_high, rng);
+
+    // 在线：树状数组套线段树
+    auto t0 = chrono::high_resolution_clock::now();
+    BITOfSegmentTrees online(initial, 0, value_high);
+    vector<int> online_answers;
+    for (const Operation& op : operations) {
+        if (op.type == 1) online.update(op.a, op.b);
+        else online_answers.push_back(online.kth(op.a, op.b, op.c));
+    }
+    auto t1 = chrono::high_resolution_clock::now();
+
+    // 离线：整体二分
+    vector<int> offline_answers = OverallBinarySearch().run(initial, operations, 0, value_high);
+    auto t2 = chrono::high_resolution_clock::now();
+
+    // 基准：每次修改整体重建主席树，只跑前若干个操作再按比例估算
+    int rebuild_ops = min(op_count, 200);
+    RebuildPresidentTree rebuild(initial);
+    bool rebuild_ok = true;
+    int query_id = 0;
+    for (int i = 0; i < rebuild_ops; i++) {
+        const Operation& op = operations[i];
+        if (op.type == 1) rebuild.update(op.a, op.b);
+        else rebuild_ok = rebuild_ok && rebuild.kth(op.a, op.b, op.c) == online_answers[query_id++];
+    }
+    auto t3 = chrono::high_resolution_clock::now();
+
+    double online_ms = chrono::duration<double, milli>(t1 - t0).count();
+    double offline_ms = chrono::duration<double, milli>(t2 - t1).count();
+    double rebuild_ms = chrono::duration<double, milli>(t3 - t2).count();
+
+    cout << "树状数组套线段树：" << online_ms << " ms，节点数 " << online.node_count() << endl;
+    cout << "整体二分：        " << offline_ms << " ms" << endl;
+    cout << "整体重建主席树：  " << rebuild_ms << " ms（前 " << rebuild_ops << " 个操作），"
+         << "估算全部 " << rebuild_ms / rebuild_ops * op_count << " ms" << endl;
+    cout << "在线 / 离线结果一致：" << (online_answers == offline_answers ? "是" : "否") << endl;
+    cout << "重建结果一致：" << (rebuild_ok ? "是" : "否") << endl;
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int op_count = argc > 2 ? atoi(argv[2]) : 100000;
+
+    verify_against_brute_force();
+    performance_test(n, op_count);
+
+    return 0;
+}
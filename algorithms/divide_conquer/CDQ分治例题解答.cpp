@@ -7,135 +7,42 @@
  * 对于每朵花，求有多少朵花的3个属性都不超过它
  * 
  * 解题思路：
- * 1. 按第一维美丽度排序
+ * 1. 按第一维美丽度排序，相同的花合并
  * 2. CDQ分治处理第二维香味
  * 3. 树状数组维护第三维高度
+ * 实现见 cdq_engine.h 的 PartialOrder3D（自底向上迭代的 CDQ 引擎，
+ * 数组按输入规模分配，不再受 MAXN 限制）
  * 
  * 时间复杂度：O(n log² n)
- * 空间复杂度：O(n + k)
+ * 空间复杂度：O(n)
  */
 
 #include <bits/stdc++.h>
+#include "cdq_engine.h"
 using namespace std;
 
-const int MAXN = 100005;
-const int MAXK = 200005;
-
-struct Flower {
-    int a, b, c;    // 美丽度、香味、高度
-    int id;         // 原始编号
-    int cnt;        // 相同花的数量
-    
-    bool operator<(const Flower& other) const {
-        if (a != other.a) return a < other.a;
-        if (b != other.b) return b < other.b;
-        return c < other.c;
-    }
-    
-    bool operator==(const Flower& other) const {
-        return a == other.a && b == other.b && c == other.c;
-    }
-};
-
-Flower flowers[MAXN], temp[MAXN];
-int ans[MAXN];
-int tree[MAXK];
-int n, k;
-
-// 树状数组操作
-void update(int pos, int val) {
-    for (int i = pos; i <= k; i += i & -i) {
-        tree[i] += val;
-    }
-}
-
-int query(int pos) {
-    int res = 0;
-    for (int i = pos; i > 0; i -= i & -i) {
-        res += tree[i];
-    }
-    return res;
-}
-
-// CDQ分治核心函数
-void cdq(int l, int r) {
-    if (l == r) return;
-    
-    int mid = (l + r) / 2;
-    cdq(l, mid);
-    cdq(mid + 1, r);
-    
-    // 按第二维香味归并
-    int i = l, j = mid + 1, p = l;
-    
-    while (i <= mid && j <= r) {
-        if (flowers[i].b <= flowers[j].b) {
-            // 左边的花可以对右边产生贡献
-            update(flowers[i].c, flowers[i].cnt);
-            temp[p++] = flowers[i++];
-        } else {
-            // 右边的花查询左边的贡献
-            ans[flowers[j].id] += query(flowers[j].c);
-            temp[p++] = flowers[j++];
-        }
-    }
-    
-    // 处理剩余的右边元素
-    while (j <= r) {
-        ans[flowers[j].id] += query(flowers[j].c);
-        temp[p++] = flowers[j++];
-    }
-    
-    // 处理剩余的左边元素
-    while (i <= mid) {
-        update(flowers[i].c, flowers[i].cnt);
-        temp[p++] = flowers[i++];
-    }
-    
-    // 清理树状数组
-    for (int i = l; i <= mid; i++) {
-        update(flowers[i].c, -flowers[i].cnt);
-    }
-    
-    // 复制回原数组
-    for (int i = l; i <= r; i++) {
-        flowers[i] = temp[i];
-    }
-}
-
 int main() {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
     
-    cin >> n >> k;
-    
-    // 读入花的信息
-    for (int i = 0; i < n; i++) {
-        cin >> flowers[i].a >> flowers[i].b >> flowers[i].c;
-        flowers[i].id = i;
-        flowers[i].cnt = 1;
-    }
-    
-    // 按第一维美丽度排序
-    sort(flowers, flowers + n);
+    int n, k;
+    if (!(cin >> n >> k) || n <= 0) return 0;
     
-    // 去重处理，相同的花合并
-    int m = 0;
+    // 读入花的信息：美丽度、香味、高度
+    vector<int> a(n), b(n), c(n);
     for (int i = 0; i < n; i++) {
-        if (i == 0 || !(flowers[i] == flowers[i-1])) {
-            flowers[m++] = flowers[i];
-        } else {
-            flowers[m-1].cnt++;
-        }
+        cin >> a[i] >> b[i] >> c[i];
     }
     
-    // CDQ分治求解
-    cdq(0, m - 1);
+    // count[i]：三个属性都不超过第 i 朵花的其他花的数量（相同的花互相计入）
+    PartialOrder3D<int> solver;
+    vector<uint32_t> count(n);
+    solver.solve(a.data(), b.data(), c.data(), n, count.data());
     
-    // 统计答案
+    // 统计答案：等级为 d 的花有多少朵
     vector<int> result(n);
-    for (int i = 0; i < m; i++) {
-        result[flowers[i].cnt - 1] += flowers[i].cnt;
+    for (int i = 0; i < n; i++) {
+        result[count[i]]++;
     }
     
     // 输出结果
@@ -158,22 +65,22 @@ int main() {
  * 
  * 输出：
  * 1
- * 1
- * 1
  * 2
+ * 1
  * 0
+ * 1
  * 
- * 解释：
- * 花0(3,3,3)：被花1(2,3,3)和花4(1,1,1)支配，答案为2
- * 花1(2,3,3)：被花4(1,1,1)支配，答案为1
- * 花2(2,3,1)：被花4(1,1,1)支配，答案为1
- * 花3(3,1,1)：被花4(1,1,1)支配，答案为1
- * 花4(1,1,1)：没有被任何花支配，答案为0
+ * 解释（“支配”指三个属性都不超过）：
+ * 花0(3,3,3)：支配花1、花2、花3、花4，答案为4
+ * 花1(2,3,3)：支配花2(2,3,1)和花4(1,1,1)，答案为2
+ * 花2(2,3,1)：支配花4(1,1,1)，答案为1
+ * 花3(3,1,1)：支配花4(1,1,1)，答案为1
+ * 花4(1,1,1)：不支配任何花，答案为0
  * 
- * 但是题目要求的是统计每个等级的数量：
- * 0个花支配：1朵（花4）
- * 1个花支配：3朵（花1、花2、花3）
- * 2个花支配：1朵（花0）
- * 3个花支配：0朵
- * 4个花支配：0朵
- */ 
\ No newline at end of file
+ * 题目要求的是统计每个等级的数量：
+ * 等级0：1朵（花4）
+ * 等级1：2朵（花2、花3）
+ * 等级2：1朵（花1）
+ * 等级3：0朵
+ * 等级4：1朵（花0）
+ */
@@ -8,145 +8,39 @@
  * 3. 多维数点问题
  * 
  * 时间复杂度：O(n log² n)
- * 空间复杂度：O(n + k)
+ * 空间复杂度：O(n)
  */
 
 #include <bits/stdc++.h>
+#include "cdq_engine.h"
 using namespace std;
 
-const int MAXN = 100005;
-const int MAXC = 200005;
-
-/*
- * 点结构体
- * 用于存储三维坐标点
- */
-struct Point {
-    int a, b, c;    // 三维坐标
-    int id;         // 原始编号
-    int cnt;        // 相同点的数量
-    
-    bool operator<(const Point& other) const {
-        if (a != other.a) return a < other.a;
-        if (b != other.b) return b < other.b;
-        return c < other.c;
-    }
-    
-    bool operator==(const Point& other) const {
-        return a == other.a && b == other.b && c == other.c;
-    }
-};
-
-Point points[MAXN], temp[MAXN];
-int ans[MAXN];
-int tree[MAXC];
-int n, k;
-
-/*
- * 树状数组操作
- * 用于维护第三维的前缀和
- */
-void update(int pos, int val) {
-    for (int i = pos; i <= k; i += i & -i) {
-        tree[i] += val;
-    }
-}
-
-int query(int pos) {
-    int res = 0;
-    for (int i = pos; i > 0; i -= i & -i) {
-        res += tree[i];
-    }
-    return res;
-}
-
-/*
- * CDQ分治核心函数
- * 处理区间[l, r]内的三维偏序问题
- */
-void cdq(int l, int r) {
-    if (l == r) return;
-    
-    int mid = (l + r) / 2;
-    
-    // 递归处理左右两部分
-    cdq(l, mid);
-    cdq(mid + 1, r);
-    
-    // 归并过程，按第二维b排序
-    int i = l, j = mid + 1, p = l;
-    
-    while (i <= mid && j <= r) {
-        if (points[i].b <= points[j].b) {
-            // 左边的点可以对右边产生贡献
-            update(points[i].c, points[i].cnt);
-            temp[p++] = points[i++];
-        } else {
-            // 右边的点查询左边的贡献
-            ans[points[j].id] += query(points[j].c);
-            temp[p++] = points[j++];
-        }
-    }
-    
-    // 处理剩余的右边元素
-    while (j <= r) {
-        ans[points[j].id] += query(points[j].c);
-        temp[p++] = points[j++];
-    }
-    
-    // 处理剩余的左边元素
-    while (i <= mid) {
-        update(points[i].c, points[i].cnt);
-        temp[p++] = points[i++];
-    }
-    
-    // 清理树状数组，撤销左边点的贡献
-    for (int i = l; i <= mid; i++) {
-        update(points[i].c, -points[i].cnt);
-    }
-    
-    // 复制回原数组
-    for (int i = l; i <= r; i++) {
-        points[i] = temp[i];
-    }
-}
-
 /*
  * 三维偏序问题求解（陌上花开）
  * 输入：n个点，每个点有三个坐标
- * 输出：每个点被多少个点支配
+ * 输出：对 d = 0..n-1，恰好支配 d 个其他点的点数
+ * CDQ分治见 cdq_engine.h（迭代引擎 + PartialOrder3D）
  */
 void solve_3d_partial_order() {
     cout << "=== 三维偏序问题求解 ===" << endl;
     
+    int n, k;
     cin >> n >> k;
     
+    vector<int> a(n), b(n), c(n);
     for (int i = 0; i < n; i++) {
-        cin >> points[i].a >> points[i].b >> points[i].c;
-        points[i].id = i;
-        points[i].cnt = 1;
-    }
-    
-    // 按第一维排序
-    sort(points, points + n);
-    
-    // 去重处理，相同的点合并
-    int m = 0;
-    for (int i = 0; i < n; i++) {
-        if (i == 0 || !(points[i] == points[i-1])) {
-            points[m++] = points[i];
-        } else {
-            points[m-1].cnt++;
-        }
+        cin >> a[i] >> b[i] >> c[i];
     }
     
-    // CDQ分治求解
-    cdq(0, m - 1);
+    // count[i]：满足 a_j ≤ a_i, b_j ≤ b_i, c_j ≤ c_i 的 j ≠ i 个数（相同的点互相计入）
+    PartialOrder3D<int> solver;
+    vector<uint32_t> count(n);
+    solver.solve(a.data(), b.data(), c.data(), n, count.data());
     
     // 统计答案
     vector<int> result(n);
-    for (int i = 0; i < m; i++) {
-        result[points[i].cnt - 1] += points[i].cnt;
+    for (int i = 0; i < n; i++) {
+        result[count[i]]++;
     }
     
     // 输出结果
@@ -252,10 +146,11 @@ int main() {
  * 
  * 期望输出：
  * 1
- * 1
- * 1
  * 2
+ * 1
  * 0
+ * 1
+ * （各点支配数依次为 4 2 1 1 0）
  * 
  * 逆序对测试：
  * 输入：[3, 2, 1, 4]
@@ -0,0 +1,226 @@
+/*
+ * CDQ分治引擎：正确性验证与性能测试
+ * 千禧年科技学院 - アリス会长特别代码
+ *
+ * 实现见 cdq_engine.h。
+ *
+ * 1. 三维偏序：与 O(n²) 暴力逐点比较（含大量重复点、取值范围很小的情况）；
+ *    同一对象对同样规模的输入再次 solve 时，统计堆分配次数应为 0
+ * 2. 性能：n 个点、每维取值 1..n（默认 n = 10^7）
+ *    - 递归版：cdq_divide_conquer.cpp 原来的写法，全局数组换成 vector，
+ *      归并时复制 20 字节的结构体
+ *    - PartialOrder3D：离散化 + 迭代引擎；再次调用时缓冲区全部复用，不再分配内存
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 cdq_engine.cpp -o cdq_engine
+ *   ./cdq_engine [n]
+ */
+
+#include <bits/stdc++.h>
+#include "cdq_engine.h"
+using namespace std;
+
+// 统计堆分配次数，验证 PartialOrder3D 重复调用时不分配内存
+size_t allocation_count = 0;
+
+void* operator new(size_t size) {
+    allocation_count++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/*
+ * 递归版（原 cdq_divide_conquer.cpp）
+ */
+namespace recursive_cdq {
+
+struct Point {
+    int a, b, c;
+    int id;
+    int cnt;
+
+    bool operator<(const Point& other) const {
+        if (a != other.a) return a < other.a;
+        if (b != other.b) return b < other.b;
+        return c < other.c;
+    }
+    bool operator==(const Point& other) const {
+        return a == other.a && b == other.b && c == other.c;
+    }
+};
+
+vector<Point> points, temp;
+vector<int> ans, tree;
+int k;
+
+void update(int pos, int val) {
+    for (int i = pos; i <= k; i += i & -i) tree[i] += val;
+}
+
+int query(int pos) {
+    int res = 0;
+    for (int i = pos; i > 0; i -= i & -i) res += tree[i];
+    return res;
+}
+
+void cdq(int l, int r) {
+    if (l == r) return;
+    int mid = (l + r) / 2;
+    cdq(l, mid);
+    cdq(mid + 1, r);
+
+    int i = l, j = mid + 1, p = l;
+    while (i <= mid && j <= r) {
+        if (points[i].b <= points[j].b) {
+            update(points[i].c, points[i].cnt);
+            temp[p++] = points[i++];
+        } else {
+            ans[points[j].id] += query(points[j].c);
+            temp[p++] = points[j++];
+        }
+    }
+    while (j <= r) {
+        ans[points[j].id] += query(points[j].c);
+        temp[p++] = points[j++];
+    }
+    while (i <= mid) {
+        update(points[i].c, points[i].cnt);
+        temp[p++] = points[i++];
+    }
+    for (int i = l; i <= mid; i++) update(points[i].c, -points[i].cnt);
+    for (int i = l; i <= r; i++) points[i] = temp[i];
+}
+
+// 取值须在 1..maxValue
+void solve(const vector<int>& a, const vector<int>& b, const vector<int>& c, int maxValue, vector<uint32_t>& count) {
+    int n = a.size();
+    points.resize(n), temp.resize(n);
+    ans.assign(n, 0), tree.assign(maxValue + 1, 0);
+    k = maxValue;
+    for (int i = 0; i < n; i++) points[i] = Point{a[i], b[i], c[i], i, 1};
+    sort(points.begin(), points.end());
+
+    // 合并相同的点，记下每个输入点属于哪一个
+    vector<int> owner(n);
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        int id = points[i].id;
+        if (i == 0 || !(points[i] == points[m - 1])) {
+            points[m] = points[i];
+            points[m].id = m;
+            m++;
+        } else {
+            points[m - 1].cnt++;
+        }
+        owner[id] = m - 1;
+    }
+    vector<int> weight(m);
+    for (int i = 0; i < m; i++) weight[i] = points[i].cnt;
+    cdq(0, m - 1);
+    count.resize(n);
+    for (int i = 0; i < n; i++) count[i] = ans[owner[i]] + weight[owner[i]] - 1;
+}
+
+}  // namespace recursive_cdq
+
+vector<uint32_t> brute_force(const vector<int>& a, const vector<int>& b, const vector<int>& c) {
+    int n = a.size();
+    vector<uint32_t> count(n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i != j && a[j] <= a[i] && b[j] <= b[i] && c[j] <= c[i]) count[i]++;
+        }
+    }
+    return count;
+}
+
+void random_points(int n, int range, mt19937& rng, vector<int>& a, vector<int>& b, vector<int>& c) {
+    a.resize(n), b.resize(n), c.resize(n);
+    for (int i = 0; i < n; i++) {
+        a[i] = rng() % range + 1;
+        b[i] = rng() % range + 1;
+        c[i] = rng() % range + 1;
+    }
+}
+
+void test_correctness() {
+    cout << "=== 正确性验证 ===" << endl;
+    mt19937 rng(2024);
+    PartialOrder3D<int> solver;   // 反复使用同一个对象，顺带检查缓冲区复用
+
+    // 每个规模一个标记，覆盖取值范围 1、3、50、10^6（大量重复点到几乎无重复）
+    cout << "与暴力对拍（PartialOrder3D / 递归版）：";
+    for (int n : {1, 2, 3, 5, 16, 17, 100, 1000, 2500}) {
+        bool ok = true;
+        for (int range : {1, 3, 50, 1000000}) {
+            vector<int> a, b, c;
+            random_points(n, range, rng, a, b, c);
+            vector<uint32_t> expect = brute_force(a, b, c), got(n), old;
+            solver.solve(a.data(), b.data(), c.data(), n, got.data());
+            recursive_cdq::solve(a, b, c, range, old);
+            ok = ok && got == expect && old == expect;
+        }
+        cout << "n=" << n << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl;
+
+    // 同样规模再解一次：不应有任何堆分配
+    {
+        vector<int> a, b, c;
+        random_points(2500, 1000000, rng, a, b, c);
+        vector<uint32_t> got(2500), again(2500);
+        solver.solve(a.data(), b.data(), c.data(), 2500, got.data());
+        random_points(2500, 50, rng, a, b, c);
+        size_t before = allocation_count;
+        solver.solve(a.data(), b.data(), c.data(), 2500, again.data());
+        size_t allocated = allocation_count - before;
+        cout << "同规模再次调用：" << (again == brute_force(a, b, c) ? "✓ 结果正确" : "✗ 结果错误")
+             << "，" << (allocated == 0 ? "✓ 无堆分配" : "✗ 分配了 " + to_string(allocated) + " 次") << endl;
+    }
+
+    // cdq_divide_conquer.cpp 的样例：各支配数的点数为 1 2 1 0 1
+    vector<int> a = {3, 2, 2, 3, 1}, b = {3, 3, 3, 1, 1}, c = {3, 3, 1, 1, 1};
+    vector<uint32_t> count(5), level(5, 0);
+    solver.solve(a.data(), b.data(), c.data(), 5, count.data());
+    for (uint32_t x : count) level[x]++;
+    cout << "cdq_divide_conquer.cpp 样例：" << (level == vector<uint32_t>{1, 2, 1, 0, 1} ? "✓" : "✗") << endl << endl;
+}
+
+template<typename Func>
+double measure_ms(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+}
+
+void performance_test(int n) {
+    cout << "=== 性能测试：n = " << n << "，每维取值 1.." << n << " ===" << endl;
+    mt19937 rng(7);
+    vector<int> a, b, c;
+    random_points(n, n, rng, a, b, c);
+
+    vector<uint32_t> old, got(n);
+    double t_old = measure_ms([&] { recursive_cdq::solve(a, b, c, n, old); });
+    printf("  递归版（结构体归并）      %10.1f ms\n", t_old);
+
+    PartialOrder3D<int> solver;
+    double t_new = measure_ms([&] { solver.solve(a.data(), b.data(), c.data(), n, got.data()); });
+    // 第二次调用：缓冲区已就绪
+    size_t before = allocation_count;
+    double t_again = measure_ms([&] { solver.solve(a.data(), b.data(), c.data(), n, got.data()); });
+    printf("  PartialOrder3D            %10.1f ms（再次调用 %.1f ms，分配 %zu 次）  %s\n", t_new, t_again,
+           allocation_count - before, got == old ? "" : "[结果不一致]");
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+
+    test_correctness();
+    performance_test(n);
+
+    return 0;
+}
@@ -1,6 +1,14 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
 /**
@@ -22,6 +30,15 @@ using namespace std;
  * - n的二进制子集共有2^k个（包括0）
  * - 在1<=m<=n范围内，是n的二进制子集的m有2^k-1个（排除m=0）
  * - 因此，满足C(m,n)是偶数的m有：n - (2^k - 1) = n - 2^k + 1个
+ * 
+ * 批量接口 solveMany：k 用硬件 popcount 求，CPU 支持 AVX-512 VPOPCNTQ 时
+ * 一条指令处理 8 个数，否则逐个用 POPCNT 指令（再不支持则用编译器的通用实现）。
+ * 按 uint64 运算时 2^64 回绕为 0，n = 2^64 - 1 也能得到正确答案 0。
+ * 
+ * 编译运行：
+ *   g++ -O2 -std=c++17 binomial_parity.cpp -o binomial_parity
+ *   ./binomial_parity                 # 测试 + 交互式求解
+ *   ./binomial_parity 50000000        # 另跑批量接口吞吐量测试
  */
 
 class BinomialParity {
@@ -32,13 +49,45 @@ private:
      * @return n的二进制表示中1的个数
      */
     int countBits(long long n) {
-        int count = 0;
-        while (n > 0) {
-            count += n & 1;
-            n >>= 1;
+        return __builtin_popcountll(n);
+    }
+    
+    // 单个数的答案，uint64 回绕运算（n = 0 时为 0）
+    static uint64_t evenCount(uint64_t n, int k) {
+        return n + 1 - (k < 64 ? 1ULL << k : 0);
+    }
+    
+    static void solveManyGeneric(const uint64_t* n, size_t count, uint64_t* out) {
+        for (size_t i = 0; i < count; i++) out[i] = evenCount(n[i], __builtin_popcountll(n[i]));
+    }
+    
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("popcnt")))
+    static void solveManyPopcnt(const uint64_t* n, size_t count, uint64_t* out) {
+        for (size_t i = 0; i < count; i++) out[i] = evenCount(n[i], __builtin_popcountll(n[i]));
+    }
+    
+    // 8 个一组：VPOPCNTQ 求 k，VPSLLVQ 求 2^k（移位量 64 时结果为 0，正好对应回绕）
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    static void solveManyAvx512(const uint64_t* n, size_t count, uint64_t* out) {
+        const __m512i one = _mm512_set1_epi64(1);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m512i v = _mm512_loadu_si512((const void*)(n + i));
+            __m512i power = _mm512_maskz_sllv_epi64(0xFF, one, _mm512_popcnt_epi64(v));
+            __m512i r = _mm512_sub_epi64(_mm512_add_epi64(v, one), power);
+            _mm512_storeu_si512((void*)(out + i), r);
+        }
+        // 尾部用掩码处理
+        if (i < count) {
+            __mmask8 mask = (__mmask8)((1u << (count - i)) - 1);
+            __m512i v = _mm512_maskz_loadu_epi64(mask, n + i);
+            __m512i power = _mm512_maskz_sllv_epi64(0xFF, one, _mm512_popcnt_epi64(v));
+            __m512i r = _mm512_sub_epi64(_mm512_add_epi64(v, one), power);
+            _mm512_mask_storeu_epi64(out + i, mask, r);
         }
-        return count;
     }
+#endif
     
     /**
      * 计算2的k次幂
@@ -69,6 +118,23 @@ public:
         return n - oddCount;
     }
     
+    /**
+     * 批量求解：out[i] = 满足C(m,n[i])是偶数的m的个数（1<=m<=n[i]）
+     * 自动选择 AVX-512 VPOPCNTQ / POPCNT / 通用实现
+     * @param n 输入数组
+     * @param count 元素个数
+     * @param out 输出数组，可以与 n 相同（就地计算）
+     */
+    void solveMany(const uint64_t* n, size_t count, uint64_t* out) const {
+#if defined(__x86_64__) || defined(__i386__)
+        static const bool hasAvx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+        static const bool hasPopcnt = __builtin_cpu_supports("popcnt");
+        if (hasAvx512) return solveManyAvx512(n, count, out);
+        if (hasPopcnt) return solveManyPopcnt(n, count, out);
+#endif
+        solveManyGeneric(n, count, out);
+    }
+    
     /**
      * 验证算法正确性的暴力方法
      * 直接计算每个C(m,n)的奇偶性（仅适用于小的n值）
@@ -144,6 +210,61 @@ public:
     }
 };
 
+/**
+ * 批量接口正确性：与逐个 solve 比较，另含 0、2^63、2^64-1 等边界值
+ */
+void batchCorrectness() {
+    BinomialParity solver;
+    
+    cout << "\n=== 批量接口 solveMany ===" << endl;
+    
+    mt19937_64 rng(2024);
+    vector<uint64_t> small(1003);
+    for (auto& x : small) x = rng() >> (rng() % 63 + 1);
+    small[0] = 0, small[1] = 1, small[2] = 1ULL << 62;
+    vector<uint64_t> out(small.size());
+    solver.solveMany(small.data(), small.size(), out.data());
+    bool ok = true;
+    for (size_t i = 0; i < small.size(); i++) ok &= out[i] == (uint64_t)solver.solve(small[i]);
+    uint64_t edge[] = {1ULL << 63, ~0ULL, ~0ULL - 1};
+    uint64_t edgeOut[3], edgeExpect[] = {(1ULL << 63) - 1, 0, (1ULL << 63) - 1};
+    solver.solveMany(edge, 3, edgeOut);
+    for (int i = 0; i < 3; i++) ok &= edgeOut[i] == edgeExpect[i];
+    cout << "与逐个 solve 对比: " << (ok ? "✅ 一致" : "❌ 不一致") << endl;
+}
+
+/**
+ * 吞吐量测试：数组长度 count，重复多遍取平均
+ */
+void batchBenchmark(size_t count) {
+    BinomialParity solver;
+    
+    cout << "\n=== solveMany 吞吐量（长度 " << count << "）===" << endl;
+    
+    mt19937_64 rng(2025);
+    vector<uint64_t> values(count), results(count);
+    for (auto& x : values) x = rng();
+    const int ROUNDS = 5;
+    
+    auto start = chrono::high_resolution_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < count; i++) results[i] = solver.solve((long long)(values[i] >> 1));
+    }
+    double single = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    uint64_t checksum = 0;
+    for (uint64_t x : results) checksum += x;
+    
+    start = chrono::high_resolution_clock::now();
+    for (int r = 0; r < ROUNDS; r++) solver.solveMany(values.data(), count, results.data());
+    double batch = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    for (uint64_t x : results) checksum += x;
+    
+    double total = (double)count * ROUNDS;
+    printf("逐个 solve:  %8.1f M 个/秒\n", total / single / 1e6);
+    printf("solveMany:   %8.1f M 个/秒（%.2f GB/s 读写, 校验和 %llu）\n",
+           total / batch / 1e6, total * 16 / batch / 1e9, (unsigned long long)checksum);
+}
+
 /**
  * 交互式求解函数
  */
@@ -179,11 +300,14 @@ void interactiveSolve() {
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     BinomialParity solver;
     
     // 运行测试
     solver.test();
+    batchCorrectness();
+    // 批量吞吐量测试要分配 2 × 长度 个 uint64_t，只在命令行给出长度时运行（例如 50000000）
+    if (argc > 1) batchBenchmark(atoll(argv[1]));
     
     // 交互式求解
     interactiveSolve();
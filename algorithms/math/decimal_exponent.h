@@ -0,0 +1,116 @@
+/*
+ * 十进制大指数：18 位一组的分组存储、按模约化
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 指数以十进制字符串给出、长达 10^6 位时（如 P1397 的 n、m），逐字符 r = (r·10 + c) % m
+ * 要做 L 次 64 位取模。这里把字符串切成 18 位一组（10^18 < 2^60），高位组在前：
+ *
+ * - mod(m)       r ← (r·10^18 + chunk) mod m，每组一次 128 位运算，共 ⌈L/18⌉ 次；
+ *                m 可以是任意 64 位模数，如 φ(p) 或矩阵的阶
+ * - reduce(T)    把指数化到 64 位以内供普通快速幂使用：e < T 时原样返回，
+ *                否则返回 e mod T + T。若 M^(t+T) = M^t 对所有 t ≥ t0 成立且 t0 ≤ T，
+ *                则 M^e = M^reduce(T)。只取 e mod T 会在 M 不可逆时出错，
+ *                例如 [[0, y], [0, 1]] 幂等，而 e ≡ 0 时 M^0 = I
+ * - decrement()  在分组上直接减一（n - 1、m - 1 一类的指数）
+ * - forEachDigit 从高位到低位逐个给出十进制数字（不含前导零），
+ *                供 matrix_power.h 的十进制窗口快速幂使用
+ *
+ * 时间复杂度：构造、mod、reduce 均为 O(L/18) 次 128 位运算
+ */
+
+#ifndef DECIMAL_EXPONENT_H
+#define DECIMAL_EXPONENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class DecimalExponent {
+public:
+    static const int DIGITS = 18;
+    static const uint64_t BASE = 1000000000000000000ULL;   // 10^18
+
+private:
+    std::vector<uint64_t> chunks;   // 高位组在前，每组 < 10^18
+
+public:
+    DecimalExponent() = default;
+
+    // s 只含数字，允许前导零；空串视为 0
+    explicit DecimalExponent(const std::string& s) {
+        size_t start = 0;
+        while (start < s.size() && s[start] == '0') start++;
+        size_t len = s.size() - start;
+        size_t head = len % DIGITS == 0 ? DIGITS : len % DIGITS;
+        for (size_t pos = start; pos < s.size(); ) {
+            size_t width = pos == start ? head : DIGITS;
+            uint64_t v = 0;
+            for (size_t i = pos; i < pos + width; i++) v = v * 10 + (s[i] - '0');
+            chunks.push_back(v);
+            pos += width;
+        }
+    }
+
+    explicit DecimalExponent(uint64_t e) : DecimalExponent(std::to_string(e)) {}
+
+    bool isZero() const {
+        for (uint64_t c : chunks) {
+            if (c) return false;
+        }
+        return true;
+    }
+
+    // 减一（要求非零）；最高组变成 0 时去掉
+    void decrement() {
+        for (size_t i = chunks.size(); i-- > 0; ) {
+            if (chunks[i] > 0) {
+                chunks[i]--;
+                break;
+            }
+            chunks[i] = BASE - 1;
+        }
+        if (!chunks.empty() && chunks[0] == 0) chunks.erase(chunks.begin());
+    }
+
+    // 指数 mod m（m ≥ 1）：r < m < 2^64，r·10^18 + chunk < 2^124
+    uint64_t mod(uint64_t m) const {
+        unsigned __int128 r = 0;
+        for (uint64_t c : chunks) r = (r * BASE + c) % m;
+        return (uint64_t)r;
+    }
+
+    // 指数是否 < m
+    bool lessThan(uint64_t m) const {
+        size_t i = 0;
+        while (i < chunks.size() && chunks[i] == 0) i++;
+        if (chunks.size() - i > 2) return false;   // ≥ 10^36
+        unsigned __int128 v = 0;
+        for (; i < chunks.size(); i++) v = v * BASE + chunks[i];
+        return v < m;
+    }
+
+    // e < T 时为 e，否则为 e mod T + T（要求 1 ≤ T ≤ 2^63，结果不超过 2^64 - 1）
+    uint64_t reduce(uint64_t period) const {
+        uint64_t r = mod(period);
+        return lessThan(period) ? r : r + period;
+    }
+
+    // 按从高到低的顺序对每个十进制数字调用 f(digit)，不含前导零；指数为 0 时不调用
+    template<typename F>
+    void forEachDigit(F&& f) const {
+        bool leading = true;
+        for (uint64_t c : chunks) {
+            uint64_t scale = BASE / 10;
+            for (int k = 0; k < DIGITS; k++, scale /= 10) {
+                int digit = (int)(c / scale % 10);
+                if (leading && digit == 0) continue;
+                leading = false;
+                f(digit);
+            }
+        }
+    }
+
+    size_t chunkCount() const { return chunks.size(); }
+};
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ * 增量高斯消元内核（行阶梯形基）
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 维护一组线性无关向量的行阶梯形：每个基向量有一个主元列，
+ * 主元位置系数为 1，且后插入的向量在之前所有主元列上都为 0。
+ * 于是按插入顺序依次消去即可把任意向量约化，不需要从头消元。
+ *
+ * - GF2Basis              GF(2)，向量按 64 位打包，消去一次是 dim/64 次异或
+ * - ModPBasis<MOD>         GF(p)，内部用 Montgomery 形式做乘法，避免取模除法
+ * - RealBasis              实数（double），插入时选绝对值最大的分量作主元
+ *
+ * 统一接口（Vector 为各自的向量类型）：
+ *   canInsert(v)   与当前基是否线性无关，O(rank · dim)
+ *   insert(v)      线性无关时加入基并返回 true，O(rank · dim)
+ *   popBack()      撤销最近一次成功的 insert，O(1)
+ *   rank() / dimension() / clear()
+ *
+ * 用途：LinearMatroid 的独立性判定（见 matroid_algorithms.cpp），
+ * 贪心的总代价从每次重新消元的 O(m · rank² · dim) 降为 O(m · rank · dim)。
+ */
+
+#ifndef ELIMINATION_BASIS_H
+#define ELIMINATION_BASIS_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "mod_int.h"
+
+// =============================================================================
+// GF(2)：位打包
+// =============================================================================
+
+class GF2Basis {
+public:
+    typedef std::vector<uint64_t> Vector;   // 第 i 个分量是 v[i/64] 的第 i%64 位
+
+private:
+    int dim, words;
+    std::vector<uint64_t> rows;   // 第 k 个基向量占 rows[k*words .. (k+1)*words)
+    std::vector<int> pivots;      // 第 k 个基向量的主元列
+
+    // 就地约化，返回约化后是否非零
+    bool reduce(uint64_t* v) const {
+        for (size_t k = 0; k < pivots.size(); k++) {
+            int p = pivots[k];
+            if (v[p >> 6] >> (p & 63) & 1) {
+                const uint64_t* row = &rows[k * words];
+                for (int i = 0; i < words; i++) v[i] ^= row[i];
+            }
+        }
+        for (int i = 0; i < words; i++) if (v[i]) return true;
+        return false;
+    }
+
+public:
+    explicit GF2Basis(int dim) : dim(dim), words((dim + 63) / 64) {}
+
+    static Vector makeVector(int dim) { return Vector((dim + 63) / 64, 0); }
+    static void setBit(Vector& v, int i) { v[i >> 6] |= 1ULL << (i & 63); }
+
+    bool canInsert(const Vector& x) const {
+        Vector v = x;
+        return reduce(v.data());
+    }
+
+    bool insert(const Vector& x) {
+        Vector v = x;
+        if (!reduce(v.data())) return false;
+        int p = 0;
+        while (!v[p >> 6]) p += 64;
+        p += __builtin_ctzll(v[p >> 6]);
+        rows.insert(rows.end(), v.begin(), v.end());
+        pivots.push_back(p);
+        return true;
+    }
+
+    int rank() const { return pivots.size(); }
+    int dimension() const { return dim; }
+    void clear() {
+        rows.clear();
+        pivots.clear();
+    }
+
+    // 撤销最近一次成功的 insert
+    void popBack() {
+        rows.resize(rows.size() - words);
+        pivots.pop_back();
+    }
+};
+
+// =============================================================================
+// GF(p)：Montgomery 乘法，MOD 为小于 2^30 的奇素数
+// =============================================================================
+
+template<uint32_t MOD>
+class ModPBasis {
+    static_assert(MOD % 2 == 1 && MOD < (1u << 30), "MOD 必须是小于 2^30 的奇数");
+
+public:
+    typedef std::vector<uint32_t> Vector;   // 分量取值 [0, MOD)
+
+private:
+    static constexpr Montgomery32 ctx{MOD};   // 见 mod_int.h
+
+    static uint32_t toMont(uint32_t x) { return ctx.toMont(x); }
+    static uint32_t mul(uint32_t a, uint32_t b) { return ctx.mul(a, b); }
+
+    static uint32_t power(uint32_t a, uint32_t e) {
+        uint32_t r = toMont(1);
+        while (e) {
+            if (e & 1) r = mul(r, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return r;
+    }
+
+    int dim;
+    std::vector<uint32_t> rows;   // Montgomery 形式，主元处为 1
+    std::vector<int> pivots;
+
+    // v 为 Montgomery 形式，就地约化，返回第一个非零分量（全零返回 -1）
+    int reduce(uint32_t* v) const {
+        for (size_t k = 0; k < pivots.size(); k++) {
+            uint32_t f = v[pivots[k]];
+            if (!f) continue;
+            const uint32_t* row = &rows[k * dim];
+            for (int i = 0; i < dim; i++) {
+                uint32_t t = mul(f, row[i]);
+                v[i] = v[i] >= t ? v[i] - t : v[i] + MOD - t;
+            }
+        }
+        for (int i = 0; i < dim; i++) if (v[i]) return i;
+        return -1;
+    }
+
+    std::vector<uint32_t> load(const Vector& x) const {
+        std::vector<uint32_t> v(dim);
+        for (int i = 0; i < dim; i++) v[i] = toMont(x[i] % MOD);
+        return v;
+    }
+
+public:
+    explicit ModPBasis(int dim) : dim(dim) {}
+
+    bool canInsert(const Vector& x) const {
+        std::vector<uint32_t> v = load(x);
+        return reduce(v.data()) >= 0;
+    }
+
+    bool insert(const Vector& x) {
+        std::vector<uint32_t> v = load(x);
+        int p = reduce(v.data());
+        if (p < 0) return false;
+        // 主元归一：乘以 v[p] 的逆（费马小定理）
+        uint32_t inv = power(v[p], MOD - 2);
+        for (int i = 0; i < dim; i++) v[i] = mul(v[i], inv);
+        rows.insert(rows.end(), v.begin(), v.end());
+        pivots.push_back(p);
+        return true;
+    }
+
+    int rank() const { return pivots.size(); }
+    int dimension() const { return dim; }
+    void clear() {
+        rows.clear();
+        pivots.clear();
+    }
+
+    // 撤销最近一次成功的 insert
+    void popBack() {
+        rows.resize(rows.size() - dim);
+        pivots.pop_back();
+    }
+};
+
+// =============================================================================
+// 实数：double，绝对值小于 eps 视为 0
+// =============================================================================
+
+class RealBasis {
+public:
+    typedef std::vector<double> Vector;
+
+private:
+    int dim;
+    double eps;
+    std::vector<double> rows;   // 主元处为 1
+    std::vector<int> pivots;
+
+    // 就地约化，返回绝对值最大的分量（全部小于 eps 时返回 -1）
+    int reduce(double* v) const {
+        for (size_t k = 0; k < pivots.size(); k++) {
+            double f = v[pivots[k]];
+            if (f == 0) continue;
+            const double* row = &rows[k * dim];
+            for (int i = 0; i < dim; i++) v[i] -= f * row[i];
+            v[pivots[k]] = 0;
+        }
+        int best = -1;
+        for (int i = 0; i < dim; i++) {
+            if (std::fabs(v[i]) > eps && (best < 0 || std::fabs(v[i]) > std::fabs(v[best]))) best = i;
+        }
+        return best;
+    }
+
+public:
+    explicit RealBasis(int dim, double eps = 1e-9) : dim(dim), eps(eps) {}
+
+    bool canInsert(const Vector& x) const {
+        Vector v = x;
+        return reduce(v.data()) >= 0;
+    }
+
+    bool insert(const Vector& x) {
+        Vector v = x;
+        int p = reduce(v.data());
+        if (p < 0) return false;
+        double inv = 1.0 / v[p];
+        for (int i = 0; i < dim; i++) v[i] *= inv;
+        v[p] = 1;
+        rows.insert(rows.end(), v.begin(), v.end());
+        pivots.push_back(p);
+        return true;
+    }
+
+    int rank() const { return pivots.size(); }
+    int dimension() const { return dim; }
+    void clear() {
+        rows.clear();
+        pivots.clear();
+    }
+
+    // 撤销最近一次成功的 insert
+    void popBack() {
+        rows.resize(rows.size() - dim);
+        pivots.pop_back();
+    }
+};
+
+#endif
@@ -1,6 +1,15 @@
 #include <iostream>
+#include <climits>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <chrono>
 using namespace std;
 
 /**
@@ -15,15 +24,27 @@ using namespace std;
  * |Ai ∩ Aj| = N / lcm(ai, aj)
  */
 
-// 计算最大公约数
+// 计算最大公约数（二进制 GCD：用 __builtin_ctzll 一次去掉所有因子 2，只做减法和移位）
 long long gcd(long long a, long long b) {
-    if (b == 0) return a;
-    return gcd(b, a % b);
+    unsigned long long x = a, y = b;
+    if (x == 0) return y;
+    if (y == 0) return x;
+    int shift = __builtin_ctzll(x | y);
+    x >>= __builtin_ctzll(x);
+    while (y) {
+        y >>= __builtin_ctzll(y);
+        if (x > y) swap(x, y);
+        y -= x;
+    }
+    return x << shift;
 }
 
 // 计算最小公倍数
+// 先除后乘仍可能超出 long long（N 接近 10^18 时很常见），乘法在 __int128 中进行，
+// 超出范围时返回 LLONG_MAX，调用方的 “<= N” 判断自然失败
 long long lcm(long long a, long long b) {
-    return a / gcd(a, b) * b;  // 先除后乘避免溢出
+    __int128 r = (__int128)(a / gcd(a, b)) * b;
+    return r > LLONG_MAX ? LLONG_MAX : (long long)r;
 }
 
 /**
@@ -74,6 +95,250 @@ long long solve_inclusion_exclusion(vector<long long> nums, long long N) {
     return inclusion_exclusion_recursive(nums, 0, 1, 0, N);
 }
 
+/**
+ * 容斥计数引擎：大量除数、多个 N 的批量计数
+ *
+ * 相比上面的二叉递归：
+ * 1. 预处理：去重；若 a | b，则 b 的倍数都是 a 的倍数，b 对并集没有贡献，直接删除
+ * 2. 除数按从大到小排序，大数让 LCM 尽早超过 N，越靠近根剪枝越多
+ * 3. 枚举方式改为“每个节点就是一个子集，子节点只追加更靠后的除数”，
+ *    树上每个节点都是 LCM <= N 的有效子集，不再沿“不选”分支走到叶子
+ * 4. 多个 N 共用一次遍历：N 从大到小排好，节点 LCM 为 L 时只更新 N >= L 的那些查询，
+ *    剪枝按最大的 N 进行
+ * 5. 多线程：每个线程有自己的双端队列，剩余除数较多的子树作为任务压入自己的队列，
+ *    自己从队尾取，空闲时从其他线程的队首窃取（工作窃取）
+ *
+ * 各线程的累加器用无符号数，中间结果溢出时按模 2^64 回绕，最终结果仍然精确。
+ */
+class InclusionExclusionEngine {
+private:
+    vector<long long> nums;          // 预处理后的除数，从大到小
+    vector<long long> sorted_n;      // 查询的 N，从大到小
+    long long max_n = 0;
+    
+    // 剩余除数个数超过该值的子树拆成任务
+    static const int SPLIT_REMAINING = 12;
+    
+    struct Task {
+        int start;          // 子节点从 nums[start] 开始追加
+        long long lcm;      // 当前子集的 LCM
+        int size;           // 当前子集大小
+    };
+    
+    // 工作窃取的共享状态
+    struct Scheduler {
+        vector<deque<Task>> queues;
+        vector<unique_ptr<mutex>> locks;
+        atomic<long long> pending{0};
+        
+        explicit Scheduler(int threads) : queues(threads) {
+            for (int i = 0; i < threads; i++) locks.emplace_back(new mutex);
+        }
+        
+        void push(int owner, const Task& task) {
+            pending++;
+            lock_guard<mutex> guard(*locks[owner]);
+            queues[owner].push_back(task);
+        }
+        
+        // 先取自己的队尾，再依次窃取其他队列的队首
+        bool pop(int owner, Task& task) {
+            int threads = queues.size();
+            for (int k = 0; k < threads; k++) {
+                int victim = (owner + k) % threads;
+                lock_guard<mutex> guard(*locks[victim]);
+                if (queues[victim].empty()) continue;
+                if (victim == owner) {
+                    task = queues[victim].back();
+                    queues[victim].pop_back();
+                } else {
+                    task = queues[victim].front();
+                    queues[victim].pop_front();
+                }
+                return true;
+            }
+            return false;
+        }
+    };
+    
+    // lcm(a, b)，超过 max_n 时返回 -1（乘法在 __int128 中进行，不会溢出）
+    long long bounded_lcm(long long a, long long b) const {
+        __int128 r = (__int128)a * (b / gcd(a, b));
+        return r > max_n ? -1 : (long long)r;
+    }
+    
+    // 子集 LCM 为 l、大小为 size 时对所有 N >= l 的查询的贡献
+    void add_contribution(unsigned long long* acc, long long l, int size) const {
+        for (size_t j = 0; j < sorted_n.size() && sorted_n[j] >= l; j++) {
+            unsigned long long c = sorted_n[j] / l;
+            if (size & 1) acc[j] += c;
+            else acc[j] -= c;
+        }
+    }
+    
+    // 串行枚举以 (l, size) 为根、从 nums[start] 起追加的子树（不含根自身）
+    void dfs(int start, long long l, int size, unsigned long long* acc) const {
+        for (int i = start; i < (int)nums.size(); i++) {
+            long long nl = bounded_lcm(l, nums[i]);
+            if (nl < 0) continue;
+            add_contribution(acc, nl, size + 1);
+            dfs(i + 1, nl, size + 1, acc);
+        }
+    }
+    
+    // 处理一个任务：剩余除数多的子节点压成新任务，其余直接串行枚举
+    void run_task(const Task& task, int owner, Scheduler& scheduler, unsigned long long* acc) const {
+        int k = nums.size();
+        for (int i = task.start; i < k; i++) {
+            long long nl = bounded_lcm(task.lcm, nums[i]);
+            if (nl < 0) continue;
+            add_contribution(acc, nl, task.size + 1);
+            if (k - (i + 1) > SPLIT_REMAINING) {
+                scheduler.push(owner, Task{i + 1, nl, task.size + 1});
+            } else {
+                dfs(i + 1, nl, task.size + 1, acc);
+            }
+        }
+    }
+    
+public:
+    explicit InclusionExclusionEngine(vector<long long> divisors) {
+        sort(divisors.begin(), divisors.end());
+        divisors.erase(unique(divisors.begin(), divisors.end()), divisors.end());
+        
+        // 删除是其他除数倍数的除数（从小到大扫描，只需和已保留的比较）
+        for (long long d : divisors) {
+            if (d <= 0) continue;
+            bool redundant = false;
+            for (long long kept : nums) {
+                if (d % kept == 0) {
+                    redundant = true;
+                    break;
+                }
+            }
+            if (!redundant) nums.push_back(d);
+        }
+        reverse(nums.begin(), nums.end());
+    }
+    
+    // 对每个 N，计算 [1, N] 中至少是一个除数倍数的整数个数
+    vector<long long> count_union(const vector<long long>& queries, int threads = 1) {
+        int q = queries.size();
+        vector<int> order(q);
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return queries[a] > queries[b]; });
+        sorted_n.resize(q);
+        for (int j = 0; j < q; j++) sorted_n[j] = queries[order[j]];
+        max_n = q ? max(0LL, sorted_n[0]) : 0;
+        
+        threads = max(1, threads);
+        vector<vector<unsigned long long>> acc(threads, vector<unsigned long long>(q, 0));
+        
+        if (threads == 1) {
+            dfs(0, 1, 0, acc[0].data());
+        } else {
+            Scheduler scheduler(threads);
+            scheduler.push(0, Task{0, 1, 0});
+            vector<thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&, t] {
+                    Task task;
+                    while (scheduler.pending.load() > 0) {
+                        if (scheduler.pop(t, task)) {
+                            run_task(task, t, scheduler, acc[t].data());
+                            scheduler.pending--;
+                        } else {
+                            this_thread::yield();
+                        }
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+        }
+        
+        vector<long long> result(q);
+        for (int j = 0; j < q; j++) {
+            unsigned long long total = 0;
+            for (int t = 0; t < threads; t++) total += acc[t][j];
+            result[order[j]] = (long long)total;
+        }
+        return result;
+    }
+    
+    long long count_union(long long N, int threads = 1) {
+        return count_union(vector<long long>{N}, threads)[0];
+    }
+    
+    // 预处理后保留的除数个数
+    int divisor_count() const { return nums.size(); }
+};
+
+/**
+ * 按整除个数分类计数：一次枚举同时得到
+ *   at_least_one  —— [1, N] 中至少是一个除数倍数的个数
+ *   exactly[j]    —— [1, N] 中恰好是 j 个除数倍数的个数（j = 0..k）
+ *
+ * 枚举所有 LCM <= N 的子集 T，按大小累加 S_m = Σ_{|T|=m} floor(N / lcm(T))，然后
+ *   at_least_one = Σ_{m>=1} (-1)^(m+1) S_m
+ *   exactly[j]   = Σ_{m>=j} (-1)^(m-j) C(m, j) S_m
+ * （恰好被 t 个除数整除的数在 S_m 中被计了 C(t, m) 次，代入即得。）
+ *
+ * “恰好 j 个”与除数的具体取值有关，因此这里不删除互为倍数的除数，重复的除数按重数计。
+ * S_m 与组合数都在模 2^64 下计算：最终结果在 [0, N] 内，回绕不影响正确性。
+ * LCM 用 __int128 计算，N 可以取到 long long 上限。
+ */
+struct DivisibilityCounts {
+    long long at_least_one;
+    vector<long long> exactly;
+};
+
+void accumulate_subset_sums(const vector<long long>& nums, int start, long long l, int size,
+                            long long N, vector<unsigned long long>& sums) {
+    for (int i = start; i < (int)nums.size(); i++) {
+        __int128 nl = (__int128)l * (nums[i] / gcd(l, nums[i]));
+        if (nl > N) continue;
+        sums[size + 1] += (unsigned long long)(N / (long long)nl);
+        accumulate_subset_sums(nums, i + 1, (long long)nl, size + 1, N, sums);
+    }
+}
+
+DivisibilityCounts count_divisibility(vector<long long> nums, long long N) {
+    int k = nums.size();
+    DivisibilityCounts result{0, vector<long long>(k + 1, 0)};
+    if (N <= 0) return result;
+    
+    // 从大到小排序，尽早剪枝
+    sort(nums.rbegin(), nums.rend());
+    vector<unsigned long long> sums(k + 1, 0);
+    accumulate_subset_sums(nums, 0, 1, 0, N, sums);
+    sums[0] = N;
+    
+    // 组合数 C(m, j) mod 2^64（帕斯卡三角只用加法）
+    vector<vector<unsigned long long>> binom(k + 1, vector<unsigned long long>(k + 1, 0));
+    for (int m = 0; m <= k; m++) {
+        binom[m][0] = 1;
+        for (int j = 1; j <= m; j++) binom[m][j] = binom[m - 1][j - 1] + (j < m ? binom[m - 1][j] : 0);
+    }
+    
+    unsigned long long union_count = 0;
+    for (int m = 1; m <= k; m++) {
+        if (m & 1) union_count += sums[m];
+        else union_count -= sums[m];
+    }
+    result.at_least_one = (long long)union_count;
+    
+    for (int j = 0; j <= k; j++) {
+        unsigned long long e = 0;
+        for (int m = j; m <= k; m++) {
+            unsigned long long term = binom[m][j] * sums[m];
+            if ((m - j) & 1) e -= term;
+            else e += term;
+        }
+        result.exactly[j] = (long long)e;
+    }
+    return result;
+}
+
 /**
  * 测试函数：验证算法正确性
  */
@@ -99,6 +364,109 @@ void test_algorithm() {
     cout << endl;
 }
 
+/**
+ * 容斥计数引擎：与原递归实现对拍，并比较性能
+ */
+void test_engine() {
+    cout << "=== 容斥计数引擎测试 ===" << endl;
+    
+    mt19937_64 rng(2024);
+    bool ok = true;
+    for (int round = 0; round < 300 && ok; round++) {
+        int k = rng() % 12 + 1;
+        vector<long long> nums(k);
+        for (long long& x : nums) x = rng() % 60 + 1;
+        vector<long long> queries(rng() % 5 + 1);
+        for (long long& n : queries) n = rng() % 100000;
+        
+        InclusionExclusionEngine engine(nums);
+        vector<long long> batch = engine.count_union(queries, round % 3 + 1);
+        for (size_t j = 0; j < queries.size(); j++) {
+            ok = ok && batch[j] == solve_inclusion_exclusion(nums, queries[j]);
+        }
+    }
+    cout << "随机对拍（含批量、多线程）: " << (ok ? "一致" : "不一致") << endl;
+    cout << endl;
+}
+
+void benchmark_engine(int k, long long N, int threads) {
+    cout << "=== 性能测试：" << k << " 个除数，N = " << N << " ===" << endl;
+    
+    mt19937_64 rng(7);
+    vector<long long> nums(k);
+    for (long long& x : nums) x = rng() % 9900 + 100;
+    
+    auto time_ms = [](auto&& f) {
+        auto start = chrono::high_resolution_clock::now();
+        f();
+        return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+    };
+    
+    long long old_result = 0, new_result = 0, parallel_result = 0;
+    double old_ms = time_ms([&] { old_result = solve_inclusion_exclusion(nums, N); });
+    InclusionExclusionEngine engine(nums);
+    double new_ms = time_ms([&] { new_result = engine.count_union(N); });
+    double parallel_ms = time_ms([&] { parallel_result = engine.count_union(N, threads); });
+    
+    cout << "预处理后保留 " << engine.divisor_count() << " 个除数" << endl;
+    cout << "原递归:         " << old_ms << " ms，结果 " << old_result << endl;
+    cout << "引擎（单线程）: " << new_ms << " ms，结果 " << new_result << endl;
+    cout << "引擎（" << threads << " 线程）:  " << parallel_ms << " ms，结果 " << parallel_result << endl;
+    
+    // 批量：1000 个不同的 N 共用一次遍历
+    vector<long long> queries(1000);
+    for (long long& n : queries) n = N / 2 + (long long)(rng() % (unsigned long long)(N / 2));
+    vector<long long> batch;
+    double batch_ms = time_ms([&] { batch = engine.count_union(queries, threads); });
+    bool same = true;
+    double single_ms = time_ms([&] {
+        for (int j = 0; j < 20; j++) same = same && engine.count_union(queries[j]) == batch[j];
+    });
+    cout << "1000 个 N 批量: " << batch_ms << " ms（逐个计算约 " << single_ms * 50 << " ms），"
+         << "抽查结果" << (same ? "一致" : "不一致") << endl;
+    cout << endl;
+}
+
+/**
+ * 大 N 与“恰好 j 个”的测试
+ */
+void test_big_n() {
+    cout << "=== 大 N 与恰好 j 个除数 ===" << endl;
+    
+    // 两个约 4·10^9 的互质数，乘积超过 2^63：改动前的 lcm 在 long long 中溢出
+    long long N = 1000000000000000000LL;
+    vector<long long> nums = {4000000007LL, 4000000009LL};
+    long long expect = N / nums[0] + N / nums[1];   // 乘积大于 N，交集为空
+    DivisibilityCounts big = count_divisibility(nums, N);
+    cout << "N = 10^18，除数 {4000000007, 4000000009}：" << big.at_least_one
+         << "（期望 " << expect << "，递归实现 " << solve_inclusion_exclusion(nums, N)
+         << "，引擎 " << InclusionExclusionEngine(nums).count_union(N) << "）" << endl;
+    
+    // 小 N 暴力对拍“恰好 j 个”（含重复除数）
+    mt19937_64 rng(11);
+    bool ok = true;
+    for (int round = 0; round < 200 && ok; round++) {
+        int k = rng() % 8 + 1;
+        vector<long long> d(k);
+        for (long long& x : d) x = rng() % 30 + 1;
+        long long n = rng() % 5000;
+        DivisibilityCounts counts = count_divisibility(d, n);
+        vector<long long> brute(k + 1, 0);
+        for (long long x = 1; x <= n; x++) {
+            int t = 0;
+            for (long long v : d) t += x % v == 0;
+            brute[t]++;
+        }
+        ok = counts.exactly == brute && counts.at_least_one == n - brute[0];
+    }
+    cout << "恰好 j 个 / 至少一个 与暴力一致: " << (ok ? "是" : "否") << endl;
+    
+    // 分布示例：[1, 10^18] 中被 {2, 3, 5, 7, 11} 中恰好 j 个整除的个数
+    DivisibilityCounts primes = count_divisibility({2, 3, 5, 7, 11}, N);
+    for (int j = 0; j <= 5; j++) cout << "恰好 " << j << " 个: " << primes.exactly[j] << endl;
+    cout << endl;
+}
+
 /**
  * 详细解释容斥原理的递归实现
  */
@@ -125,9 +493,17 @@ void explain_algorithm() {
     cout << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // 可选参数：除数个数、N、线程数
+    int k = argc > 1 ? atoi(argv[1]) : 50;
+    long long big_n = argc > 2 ? atoll(argv[2]) : 1000000000000000LL;
+    int threads = argc > 3 ? atoi(argv[3]) : max(2u, thread::hardware_concurrency());
+    
     explain_algorithm();
     test_algorithm();
+    test_engine();
+    test_big_n();
+    benchmark_engine(k, big_n, threads);
     
     // 主要示例：计算1到1000000中指定数字倍数的数量
     cout << "=== 主要示例 ===" << endl;
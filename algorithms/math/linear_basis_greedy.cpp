@@ -8,116 +8,30 @@
  * 
  * 时间复杂度：O(n log n + nk)，其中k是线性基最大大小
  * 空间复杂度：O(k)
+ * 
+ * 线性基模板见 xor_linear_basis.h（支持 32/64/128/256 位）
+ * 
+ * greedyLinearBasisBucketed：按值域分桶、从大到小逐桶处理，
+ * 基能表示剩余所有数时提前结束，避免对全部 n 个数排序
+ * 
+ * 编译运行：
+ *   g++ -O2 -std=c++17 linear_basis_greedy.cpp -o linear_basis_greedy
+ *   ./linear_basis_greedy [n]      # 分桶对比测试的规模，默认 10^7
  */
 
 #include <bits/stdc++.h>
+#include "xor_linear_basis.h"
 using namespace std;
 
-class XORLinearBasis {
-private:
-    static const int MAXLOG = 20;  // 支持最大2^20的数字
-    int basis[MAXLOG];
-    int size;
-    
-public:
-    XORLinearBasis() {
-        memset(basis, 0, sizeof(basis));
-        size = 0;
-    }
-    
-    // 检查是否可以插入数字（是否线性无关）
-    bool canInsert(int x) {
-        int temp = x;
-        for (int i = MAXLOG - 1; i >= 0; i--) {
-            if (!(temp & (1 << i))) continue;
-            if (!basis[i]) return true;  // 可以插入
-            temp ^= basis[i];
-        }
-        return false;  // 线性相关，不能插入
-    }
-    
-    // 插入数字到线性基
-    bool insert(int x) {
-        for (int i = MAXLOG - 1; i >= 0; i--) {
-            if (!(x & (1 << i))) continue;
-            if (!basis[i]) {
-                basis[i] = x;
-                size++;
-                return true;
-            }
-            x ^= basis[i];
-        }
-        return false;
-    }
-    
-    // 获取基中所有数字
-    vector<int> getBasis() {
-        vector<int> result;
-        for (int i = 0; i < MAXLOG; i++) {
-            if (basis[i]) {
-                result.push_back(basis[i]);
-            }
-        }
-        return result;
-    }
-    
-    // 获取基的大小
-    int getSize() { return size; }
-    
-    // 获取基中数字的总和
-    long long getSum() {
-        long long sum = 0;
-        for (int i = 0; i < MAXLOG; i++) {
-            if (basis[i]) {
-                sum += basis[i];
-            }
-        }
-        return sum;
-    }
-    
-    // 检查数字是否可以由基表示
-    bool canRepresent(int x) {
-        for (int i = MAXLOG - 1; i >= 0; i--) {
-            if (!(x & (1 << i))) continue;
-            if (!basis[i]) return false;
-            x ^= basis[i];
-        }
-        return true;
-    }
-    
-    // 获取能表示的最大值
-    int getMaxValue() {
-        int result = 0;
-        for (int i = MAXLOG - 1; i >= 0; i--) {
-            if (basis[i]) {
-                result = max(result, result ^ basis[i]);
-            }
-        }
-        return result;
-    }
-    
-    // 打印基的详细信息
-    void printBasis() {
-        cout << "线性基信息：" << endl;
-        cout << "大小：" << size << endl;
-        cout << "元素：";
-        for (int i = 0; i < MAXLOG; i++) {
-            if (basis[i]) {
-                cout << basis[i] << " ";
-            }
-        }
-        cout << endl;
-        cout << "总和：" << getSum() << endl;
-        cout << "最大值：" << getMaxValue() << endl;
-    }
-};
+// 本文件中的数字是 int（可以为负），按 32 位补码插入 32 位线性基
+typedef XORLinearBasis<32> IntBasis;
 
 // 贪心算法：按权重降序构造线性基
 pair<vector<int>, long long> greedyLinearBasis(vector<int> numbers, bool verbose = false) {
     // 按降序排列
     sort(numbers.begin(), numbers.end(), greater<int>());
     
-    XORLinearBasis basis;
+    IntBasis basis;
     vector<int> selected;
     
     if (verbose) {
@@ -153,6 +67,97 @@ pair<vector<int>, long long> greedyLinearBasis(vector<int> numbers, bool verbose
     return {selected, basis.getSum()};
 }
 
+// 分桶贪心：与 greedyLinearBasis 结果完全相同，但不对全部 n 个数排序
+//
+// 1. 一遍扫描求值域，再一遍扫描把值域等分成 2^16 个桶，统计每个桶的元素个数
+// 2. 从最大的桶开始，取出若干个相邻桶组成一批，按桶号计数排序分散到缓冲区
+//    （一遍扫描），之后每个桶只有少量元素，单独排序后依次插入；
+//    批大小从 4096 起每次翻倍
+// 3. 剩余的数都不超过当前桶的上界 M；若基在 M 的最高位及以下每一位
+//    都有主元，剩下的数都能被表示，立即停止（满秩是其特例）
+//
+// 桶按数值从大到小处理、桶内有序，因此插入顺序与全排序完全一致，
+// 拟阵贪心的最大权保证不变。
+pair<vector<int>, long long> greedyLinearBasisBucketed(const vector<int>& numbers) {
+    const int BUCKETS = 1 << 16;
+    // 有符号 int 的大小关系映射到无符号：翻转符号位
+    auto key = [](int x) { return (uint32_t)x ^ 0x80000000u; };
+    
+    if (numbers.empty()) return {{}, 0};
+    
+    uint32_t minKey = UINT32_MAX, maxKey = 0;
+    for (int x : numbers) {
+        minKey = min(minKey, key(x));
+        maxKey = max(maxKey, key(x));
+    }
+    // 桶号 = (key - minKey) >> shift，保证桶号不超过 2^16 - 1
+    uint32_t range = maxKey - minKey;
+    int shift = range < BUCKETS ? 0 : (32 - __builtin_clz(range)) - 16;
+    auto bucketOf = [&](uint32_t k) { return (int)((k - minKey) >> shift); };
+    
+    vector<size_t> bucketCount(BUCKETS, 0);
+    for (int x : numbers) bucketCount[bucketOf(key(x))]++;
+    
+    IntBasis basis;
+    vector<int> selected;
+    uint32_t pivotMask = 0;   // 当前基的主元位集合
+    
+    // 桶 b 之前（数值更大）插入的基是否已经能表示桶 b 及以下的所有数
+    bool hasNegative = (int)(minKey ^ 0x80000000u) < 0;
+    auto spansBelow = [&](int b) {
+        // 剩余部分含负数时带符号位，需要全部 32 个主元
+        if (hasNegative) return pivotMask == 0xFFFFFFFFu;
+        uint64_t upper = (uint64_t)minKey + (((uint64_t)b + 1) << shift) - 1;
+        int bound = (int)((uint32_t)min<uint64_t>(upper, maxKey) ^ 0x80000000u);
+        if (bound == 0) return true;
+        uint32_t need = (1u << (32 - __builtin_clz(bound))) - 1;
+        return (pivotMask & need) == need;
+    };
+    
+    vector<int> batch;
+    vector<size_t> offset;
+    size_t batchTarget = 4096;
+    int high = bucketOf(maxKey);   // 尚未处理的最高桶
+    
+    while (high >= 0 && !spansBelow(high)) {
+        // 向下扩展桶区间 [low, high]，直到元素个数达到本批目标
+        int low = high;
+        size_t count = bucketCount[low];
+        while (low > 0 && count < batchTarget) count += bucketCount[--low];
+        
+        // 按桶号分散：桶 high 在最前面
+        batch.resize(count);
+        offset.assign(high - low + 2, 0);
+        for (int b = high; b >= low; b--) offset[high - b + 1] = offset[high - b] + bucketCount[b];
+        for (int x : numbers) {
+            int b = bucketOf(key(x));
+            if (b >= low && b <= high) batch[offset[high - b]++] = x;
+        }
+        
+        // 分散后 offset[i] 指向第 i 个桶的末尾
+        size_t begin = 0;
+        for (int b = high; b >= low; b--) {
+            if (spansBelow(b)) break;
+            size_t end = offset[high - b];
+            sort(batch.begin() + begin, batch.begin() + end, greater<int>());
+            size_t before = selected.size();
+            for (size_t i = begin; i < end; i++) {
+                if (basis.insert(batch[i])) selected.push_back(batch[i]);
+            }
+            if (selected.size() != before) {
+                pivotMask = 0;
+                for (int v : basis.getBasis()) pivotMask |= 1u << (31 - __builtin_clz((uint32_t)v));
+            }
+            begin = end;
+        }
+        
+        high = low - 1;
+        batchTarget *= 2;
+    }
+    
+    return {selected, basis.getSum()};
+}
+
 // 暴力算法：尝试所有可能的子集
 pair<vector<int>, long long> bruteForceLinearBasis(vector<int> numbers, bool verbose = false) {
     int n = numbers.size();
@@ -174,7 +179,7 @@ pair<vector<int>, long long> bruteForceLinearBasis(vector<int> numbers, bool ver
         }
         
         // 检查是否线性无关
-        XORLinearBasis basis;
+        IntBasis basis;
         bool valid = true;
         for (int x : subset) {
             if (!basis.insert(x)) {
@@ -183,7 +188,7 @@ pair<vector<int>, long long> bruteForceLinearBasis(vector<int> numbers, bool ver
             }
         }
         
-        if (valid && basis.getSum() > maxSum) {
+        if (valid && (long long)basis.getSum() > maxSum) {
             maxSum = basis.getSum();
             bestBasis = subset;
             if (verbose) {
@@ -311,7 +316,7 @@ void demonstrateMatroidProperties() {
     cout << "验证遗传性（独立集的子集也是独立集）：" << endl;
     vector<int> independentSet = {15, 10, 6};  // 已知的独立集
     
-    XORLinearBasis basis;
+    IntBasis basis;
     bool isIndependent = true;
     for (int x : independentSet) {
         if (!basis.insert(x)) {
@@ -327,7 +332,7 @@ void demonstrateMatroidProperties() {
         vector<vector<int>> subsets = {{15}, {10}, {6}, {15, 10}, {15, 6}, {10, 6}};
         
         for (auto& subset : subsets) {
-            XORLinearBasis subBasis;
+            IntBasis subBasis;
             bool subIndependent = true;
             for (int x : subset) {
                 if (!subBasis.insert(x)) {
@@ -355,7 +360,7 @@ void demonstrateMatroidProperties() {
     cout << "集合B：{6, 3, 1}，大小：" << setB.size() << endl;
     
     // 由于|A| < |B|，应该能从B中找到元素加入A
-    XORLinearBasis basisA;
+    IntBasis basisA;
     for (int x : setA) {
         basisA.insert(x);
     }
@@ -400,6 +405,51 @@ void performanceTest() {
     }
 }
 
+// 大规模对比：全排序贪心 vs 分桶贪心
+void bucketedPerformanceTest(int n) {
+    cout << "⚡ 分桶贪心 vs 全排序贪心（n = " << n << "）⚡" << endl;
+    cout << endl;
+    
+    mt19937 rng(2024);
+    
+    // 小规模对拍：包含负数、重复值和很窄的值域
+    bool ok = true;
+    for (int round = 0; round < 2000 && ok; round++) {
+        int size = rng() % 20000 + 1;
+        int span = round % 3 == 0 ? 100 : round % 3 == 1 ? (1 << 24) : INT_MAX;
+        vector<int> data(size);
+        for (int& x : data) x = (int)(rng() % span) - (round % 2 ? span / 2 : 0);
+        ok = greedyLinearBasis(data) == greedyLinearBasisBucketed(data);
+    }
+    cout << "随机对拍：" << (ok ? "✓ 与全排序贪心完全一致" : "✗ 发现不一致") << endl;
+    cout << endl;
+    
+    // 数据1：随机 31 位非负数，很快满秩
+    // 数据2：只含低 20 位的数，秩不超过 20、不会满秩；全排序仍要排序全部数据，
+    //       分桶版在低 20 位主元凑齐后（spansBelow）即可提前结束
+    for (int type = 0; type < 2; type++) {
+        vector<int> data(n);
+        for (int& x : data) x = type == 0 ? (int)(rng() >> 1) : (int)(rng() & 0xFFFFF);
+        
+        auto t0 = chrono::high_resolution_clock::now();
+        auto [sortBasis, sortSum] = greedyLinearBasis(data);
+        auto t1 = chrono::high_resolution_clock::now();
+        auto [bucketBasis, bucketSum] = greedyLinearBasisBucketed(data);
+        auto t2 = chrono::high_resolution_clock::now();
+        
+        double sortMs = chrono::duration<double, milli>(t1 - t0).count();
+        double bucketMs = chrono::duration<double, milli>(t2 - t1).count();
+        
+        cout << (type == 0 ? "随机 31 位数据：" : "低 20 位数据（不满秩）：") << endl;
+        cout << "全排序：" << sortMs << " ms（" << n / sortMs / 1000 << " M/s）" << endl;
+        cout << "分桶：  " << bucketMs << " ms（" << n / bucketMs / 1000 << " M/s）" << endl;
+        cout << "基大小：" << bucketBasis.size() << "，总和：" << bucketSum
+             << "，与全排序结果一致：" << (sortBasis == bucketBasis && sortSum == bucketSum ? "是" : "否")
+             << endl;
+        cout << endl;
+    }
+}
+
 // 实际应用示例
 void practicalExample() {
     cout << "🎭 实际应用示例：数据压缩 🎭" << endl;
@@ -427,7 +477,7 @@ void practicalExample() {
     cout << endl;
     
     // 验证压缩后的数据确实可以表示原始数据中的所有数字
-    XORLinearBasis basis;
+    IntBasis basis;
     for (int x : compressed) {
         basis.insert(x);
     }
@@ -443,7 +493,69 @@ void practicalExample() {
     cout << endl;
 }
 
-int main() {
+// 验证 64 位与 256 位线性基：插入、表示、最大异或、第k小异或
+void testWideBasis() {
+    cout << "🧮 宽位线性基测试 🧮" << endl;
+    cout << endl;
+    
+    // 超过 2^20 的数字不再被截断
+    XORLinearBasis<64> basis64;
+    vector<uint64_t> big = {1ULL << 40, (1ULL << 40) | 12345, 0xFFFFFFFFFFFFULL, 1ULL << 63};
+    for (uint64_t x : big) basis64.insert(x);
+    cout << "64位基大小：" << basis64.getSize() << endl;
+    cout << "64位最大异或：" << basis64.getMaxValue() << endl;
+    cout << "能否表示 12345：" << (basis64.canRepresent(12345) ? "能" : "不能") << endl;
+    cout << endl;
+    
+    // 随机小集合，与暴力枚举所有子集对比
+    mt19937_64 rng(42);
+    bool ok = true;
+    for (int round = 0; round < 200 && ok; round++) {
+        int n = rng() % 10 + 1;
+        vector<uint64_t> numbers(n);
+        for (auto& x : numbers) {
+            // 混合高位与低位，并故意制造线性相关
+            x = (rng() & 0xF00000000000000FULL) | ((rng() % 4) << 30);
+        }
+        
+        XORLinearBasis<64> b64;
+        XORLinearBasis<256> b256;
+        for (auto x : numbers) {
+            b64.insert(x);
+            WideWord<4> wide;
+            wide.w[3] = x;  // 放在最高的字里
+            b256.insert(wide);
+        }
+        
+        set<uint64_t> values;
+        for (int mask = 1; mask < (1 << n); mask++) {
+            uint64_t v = 0;
+            for (int i = 0; i < n; i++) if (mask >> i & 1) v ^= numbers[i];
+            values.insert(v);
+        }
+        vector<uint64_t> sorted(values.begin(), values.end());
+        
+        ok = b64.getMaxValue() == sorted.back() && b256.getMaxValue().w[3] == sorted.back();
+        for (size_t k = 1; k <= sorted.size() + 1 && ok; k++) {
+            uint64_t v64;
+            WideWord<4> v256;
+            bool found64 = b64.kthSmallest(k, v64);
+            bool found256 = b256.kthSmallest(k, v256);
+            if (k <= sorted.size()) {
+                ok = found64 && found256 && v64 == sorted[k - 1] && v256.w[3] == sorted[k - 1];
+            } else {
+                ok = !found64 && !found256;
+            }
+        }
+    }
+    cout << "64/256 位随机对拍：" << (ok ? "✓ 全部一致" : "✗ 发现不一致") << endl;
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // 可选参数：分桶贪心对比测试的规模，例如 100000000
+    int bucketedN = argc > 1 ? atoi(argv[1]) : 10000000;
+    
     cout << "🌸 千禧年科技学院 - 线性基贪心算法验证 🌸" << endl;
     cout << "by ユウカ" << endl;
     cout << endl;
@@ -452,6 +564,8 @@ int main() {
     demonstrateMatroidProperties();
     performanceTest();
     practicalExample();
+    testWideBasis();
+    bucketedPerformanceTest(bucketedN);
     
     cout << "🎯 线性基贪心算法验证完成！" << endl;
     cout << endl;
@@ -0,0 +1,149 @@
+/*
+ * Lucas / 扩展 Lucas 组合数服务：正确性验证与吞吐量测试
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 实现见 lucas_binomial.h。
+ *
+ * 1. n < 2000 时与模 m 的杨辉三角逐项比较（素数、素数幂、合数模数）
+ * 2. n ≤ 10^18 时用两种独立算法互相验证：LucasBinomial(p) 与 PrimePowerBinomial(p, 1)
+ * 3. 吞吐量：n 在 [0, 10^18] 内随机，k 在 [0, n] 内随机
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 lucas_binomial.cpp -o lucas_binomial
+ *   ./lucas_binomial [询问次数]
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "lucas_binomial.h"
+
+using namespace std;
+
+/**
+ * 模 m 的杨辉三角，返回 rows 行
+ */
+vector<vector<uint32_t>> pascalTriangle(int rows, uint32_t m) {
+    vector<vector<uint32_t>> c(rows);
+    for (int i = 0; i < rows; i++) {
+        c[i].assign(i + 1, 1 % m);
+        for (int j = 1; j < i; j++) c[i][j] = ((uint64_t)c[i - 1][j - 1] + c[i - 1][j]) % m;
+    }
+    return c;
+}
+
+void testCorrectness() {
+    cout << "=== 正确性验证 ===" << endl;
+    const int ROWS = 2000;
+
+    // 小 n：与杨辉三角比较
+    cout << "Lucas 与杨辉三角（" << ROWS << " 行）：";
+    uint32_t primes[] = {2, 3, 5, 37, 1021, 1031, 10007};
+    for (uint32_t p : primes) {
+        LucasBinomial lucas(p);
+        auto c = pascalTriangle(ROWS, p);
+        bool ok = true;
+        for (int n = 0; n < ROWS && ok; n++) {
+            for (int k = 0; k <= n + 1 && ok; k++) ok = lucas.binomial(n, k) == (k <= n ? c[n][k] : 0);
+        }
+        cout << "p=" << p << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl;
+
+    cout << "BinomialService 与杨辉三角：";
+    uint32_t moduli[] = {8, 27, 1024, 3125, 9 * 49, 1000000, 10007u * 10009u, 998244352u, 1u << 27};
+    for (uint32_t m : moduli) {
+        BinomialService service(m);
+        auto c = pascalTriangle(ROWS, m);
+        bool ok = true;
+        for (int n = 0; n < ROWS && ok; n++) {
+            for (int k = 0; k <= n && ok; k++) ok = service.binomial(n, k) == c[n][k];
+        }
+        cout << "m=" << m << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl;
+
+    // 大 n：两种算法互相验证
+    mt19937_64 rng(2024);
+    const uint64_t MAX_N = 1000000000000000000ULL;
+    cout << "n ≤ 10^18，Lucas 与 PrimePowerBinomial(p, 1)：";
+    for (uint32_t p : {2u, 3u, 7u, 1009u, 1000003u}) {
+        LucasBinomial lucas(p);
+        PrimePowerBinomial wilson(p, 1);
+        bool ok = true;
+        for (int t = 0; t < 200000 && ok; t++) {
+            uint64_t n = rng() % (MAX_N + 1);
+            uint64_t k = rng() % (n + 1);
+            ok = lucas.binomial(n, k) == wilson.binomial(n, k);
+        }
+        cout << "p=" << p << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl;
+
+    // 素数幂：C(n, k) mod p^a 再模 p 应与 Lucas 一致
+    cout << "n ≤ 10^18，模 p^a 的结果再模 p 与 Lucas：";
+    for (auto pa : vector<pair<uint32_t, uint32_t>>{{2, 20}, {3, 10}, {5, 6}, {1009, 2}}) {
+        LucasBinomial lucas(pa.first);
+        PrimePowerBinomial power(pa.first, pa.second);
+        bool ok = true;
+        for (int t = 0; t < 200000 && ok; t++) {
+            uint64_t n = rng() % (MAX_N + 1);
+            uint64_t k = rng() % (n + 1);
+            ok = power.binomial(n, k) % pa.first == lucas.binomial(n, k);
+        }
+        cout << pa.first << "^" << pa.second << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl << endl;
+}
+
+template<typename Func>
+double measureSeconds(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+void throughputTest(size_t count) {
+    cout << "=== 吞吐量测试（" << count << " 次询问，n ≤ 10^18）===" << endl;
+    mt19937_64 rng(7);
+    const uint64_t MAX_N = 1000000000000000000ULL;
+    vector<uint64_t> n(count), k(count);
+    for (size_t i = 0; i < count; i++) {
+        n[i] = rng() % (MAX_N + 1);
+        k[i] = rng() % (n[i] + 1);
+    }
+    vector<uint32_t> out(count);
+
+    for (uint32_t p : {2u, 3u, 37u, 1031u, 1000003u, 100000007u}) {
+        double build = measureSeconds([&] { LucasBinomial lucas(p); });
+        LucasBinomial lucas(p);
+        double t = measureSeconds([&] { lucas.binomialMany(n.data(), k.data(), count, out.data()); });
+        uint64_t checksum = 0;
+        for (uint32_t v : out) checksum += v;
+        printf("  Lucas  p = %-10u 预处理 %7.1f ms, %6.2f M 次/秒 (校验和 %llu)\n",
+               p, build * 1000, count / t / 1e6, (unsigned long long)checksum);
+    }
+
+    for (uint32_t m : {1u << 20, 998244352u, 1000000000u}) {
+        BinomialService service(m);
+        size_t part = count / 10;
+        double t = measureSeconds([&] {
+            for (size_t i = 0; i < part; i++) out[i] = service.binomial(n[i], k[i]);
+        });
+        printf("  扩展Lucas m = %-10u %6.2f M 次/秒\n", m, part / t / 1e6);
+    }
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? atoll(argv[1]) : 10000000;
+
+    testCorrectness();
+    throughputTest(count);
+
+    return 0;
+}
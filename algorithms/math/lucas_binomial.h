@@ -0,0 +1,300 @@
+/*
+ * 大 n 组合数取模：Lucas 定理与扩展 Lucas（素数幂、合数模数）
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 证明见 Lucas定理完整证明.md。模数分析.cpp 中的 combination() 直接在 long long 里
+ * 连乘连除，只能用于很小的 n；本文件一次性预处理好表，之后每次询问只做查表与乘法。
+ *
+ * - LucasBinomial(p)         素数模数，C(n, k) = ∏ C(n_i, k_i) (mod p)，n_i 为 p 进制各位
+ *   · p ≤ 1024：把 B = p^e ≤ 1024 当作一位，预处理 B × B 的组合数表，
+ *     n ≤ 10^18 时最多 6 ~ 12 位，每位一次查表
+ *   · p > 1024：预处理 0..p-1 的阶乘与阶乘逆元，每位三次查表
+ * - PrimePowerBinomial(p, a) 模 p^a（Granville 推广）
+ *   记 (n!)_p 为 n! 去掉全部因子 p 后的部分，则
+ *     (n!)_p ≡ (±1)^{⌊n / p^a⌋} · U[n mod p^a] · (⌊n/p⌋!)_p (mod p^a)
+ *   其中 U[i] 为 1..i 中与 p 互素的数之积，±1 为一整段的乘积（广义 Wilson 定理）。
+ *   C(n, k) = p^e · (n!)_p / ((k!)_p ((n-k)!)_p)，e 为 n = k + (n-k) 在 p 进制下的进位数（Kummer）
+ * - BinomialService(m)       任意模数：分解 m，各素数幂分别求值后中国剩余定理合并
+ *
+ * 询问中按 p、p^a 的除法与取模都换成乘以预先算好的倒数（Barrett），不使用硬件除法；
+ * 扩展 Lucas 每次询问另有一次 32 位扩展欧几里得求逆元。
+ *
+ * 预处理：O(p)（大素数）或 O(B²)（小素数），素数幂 O(p^a)；表大小要求 p、p^a ≤ 2^27
+ * 单次询问：O(log_B n)
+ */
+
+#ifndef LUCAS_BINOMIAL_H
+#define LUCAS_BINOMIAL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 除以固定的 d（d ≥ 1）：d 为 2 的幂时直接移位；否则乘以预先算好的倒数，
+// 商的估计值最多偏小 1，一次比较修正。修正是否发生接近随机，写成无分支形式
+struct FastDiv {
+    uint64_t d, m;
+    int shift;   // d 为 2 的幂时为 log2(d)，否则为 -1
+
+    FastDiv(uint64_t d = 1) : d(d), m(~0ULL / d), shift((d & (d - 1)) ? -1 : __builtin_ctzll(d)) {}
+
+    uint64_t divide(uint64_t n, uint64_t& r) const {
+        if (shift >= 0) {
+            r = n & (d - 1);
+            return n >> shift;
+        }
+        uint64_t q = (uint64_t)(((unsigned __int128)n * m) >> 64);
+        r = n - q * d;
+        uint64_t fix = r >= d;
+        r -= d & (0 - fix);
+        return q + fix;
+    }
+    uint64_t mod(uint64_t n) const {
+        uint64_t r;
+        divide(n, r);
+        return r;
+    }
+};
+
+// =============================================================================
+// 素数模数：Lucas 定理
+// =============================================================================
+
+class LucasBinomial {
+    static const uint32_t SMALL_LIMIT = 1024;   // 不超过它的素数使用分块组合数表
+
+    uint32_t p;
+    FastDiv modP;
+    bool small;
+
+    // 小素数：一位为 B = p^e
+    uint32_t B;
+    FastDiv digit;
+    std::vector<uint16_t> table;   // table[a * B + b] = C(a, b) mod p
+
+    // 大素数：阶乘与阶乘逆元
+    std::vector<uint32_t> fact, invFact;
+
+    uint64_t mulMod(uint64_t a, uint64_t b) const { return modP.mod(a * b); }
+
+    uint64_t power(uint64_t a, uint64_t e) const {
+        uint64_t r = 1;
+        while (e) {
+            if (e & 1) r = mulMod(r, a);
+            a = mulMod(a, a);
+            e >>= 1;
+        }
+        return r;
+    }
+
+public:
+    /**
+     * @param p 素数，p ≤ 2^27
+     */
+    explicit LucasBinomial(uint32_t p) : p(p), modP(p), small(p <= SMALL_LIMIT) {
+        if (small) {
+            B = p;
+            while ((uint64_t)B * p <= SMALL_LIMIT) B *= p;
+            digit = FastDiv(B);
+            // 按杨辉三角模 p 填表；由 Lucas 定理，它就是 B 进制下一位的贡献
+            table.assign((size_t)B * B, 0);
+            for (uint32_t a = 0; a < B; a++) {
+                table[(size_t)a * B] = 1;
+                for (uint32_t b = 1; b <= a; b++) {
+                    uint32_t v = table[(size_t)(a - 1) * B + b - 1] + table[(size_t)(a - 1) * B + b];
+                    table[(size_t)a * B + b] = v >= p ? v - p : v;
+                }
+            }
+        } else {
+            fact.resize(p);
+            invFact.resize(p);
+            fact[0] = 1;
+            for (uint32_t i = 1; i < p; i++) fact[i] = mulMod(fact[i - 1], i);
+            invFact[p - 1] = power(fact[p - 1], p - 2);
+            for (uint32_t i = p - 1; i > 0; i--) invFact[i - 1] = mulMod(invFact[i], i);
+        }
+    }
+
+    /**
+     * C(n, k) mod p，k > n 时为 0
+     */
+    uint32_t binomial(uint64_t n, uint64_t k) const {
+        if (k > n) return 0;
+        uint64_t result = 1;
+        if (small) {
+            while (k) {
+                uint64_t ni, ki;
+                n = digit.divide(n, ni);
+                k = digit.divide(k, ki);
+                if (ki > ni) return 0;
+                result = mulMod(result, table[ni * B + ki]);
+            }
+        } else {
+            // 分子、分母分开累乘，最后只做一次乘法
+            uint64_t den = 1;
+            while (k) {
+                uint64_t ni, ki;
+                n = modP.divide(n, ni);
+                k = modP.divide(k, ki);
+                if (ki > ni) return 0;
+                result = mulMod(result, fact[ni]);
+                den = mulMod(den, mulMod(invFact[ki], invFact[ni - ki]));
+            }
+            result = mulMod(result, den);
+        }
+        return (uint32_t)result;
+    }
+
+    /**
+     * 批量询问：out[i] = C(n[i], k[i]) mod p
+     */
+    void binomialMany(const uint64_t* n, const uint64_t* k, size_t count, uint32_t* out) const {
+        for (size_t i = 0; i < count; i++) out[i] = binomial(n[i], k[i]);
+    }
+
+    uint32_t prime() const { return p; }
+};
+
+// =============================================================================
+// 素数幂模数：扩展 Lucas
+// =============================================================================
+
+class PrimePowerBinomial {
+    uint32_t p, a;
+    uint64_t pa;
+    FastDiv divP, divPa;
+    std::vector<uint32_t> unitFact;   // unitFact[i] = ∏_{j ≤ i, p ∤ j} j mod p^a
+    bool negate;                      // 一整段 [1, p^a] 中单位之积是否为 -1
+
+    uint64_t mulMod(uint64_t x, uint64_t y) const { return divPa.mod(x * y); }
+
+    // 与 p^a 互素的 x 的逆元（扩展欧几里得，p^a < 2^31，32 位除法即可）
+    uint32_t inverse(uint32_t x) const {
+        int32_t r0 = (int32_t)pa, r1 = (int32_t)x, s0 = 0, s1 = 1;
+        while (r1) {
+            int32_t q = r0 / r1, t;
+            t = r0 - q * r1, r0 = r1, r1 = t;
+            t = s0 - q * s1, s0 = s1, s1 = t;
+        }
+        return s0 < 0 ? s0 + (int32_t)pa : s0;
+    }
+
+    // 同时求 x[0..2] 的 (x!)_p mod p^a，返回 x[0]! / (x[1]! x[2]!) 中 p 的次数。
+    // 三条链互不依赖，交错执行让各自的乘法延迟与查表缺失相互重叠
+    uint64_t unitFactorials(uint64_t x[3], uint64_t f[3]) const {
+        uint64_t periods[3] = {0, 0, 0}, exponent = 0;
+        f[0] = f[1] = f[2] = 1;
+        while (x[0]) {   // x[1]、x[2] 不超过 x[0]，先变为 0 后只会乘上 U[0] = 1
+            for (int i = 0; i < 3; i++) {
+                uint64_t r;
+                periods[i] += divPa.divide(x[i], r);
+                f[i] = mulMod(f[i], unitFact[r]);
+                x[i] = divP.divide(x[i], r);
+            }
+            exponent += x[0] - x[1] - x[2];
+        }
+        for (int i = 0; i < 3; i++) {
+            if (negate && (periods[i] & 1)) f[i] = pa - f[i];
+        }
+        return exponent;
+    }
+
+public:
+    /**
+     * @param p 素数
+     * @param a 指数，p^a ≤ 2^27
+     */
+    PrimePowerBinomial(uint32_t p, uint32_t a) : p(p), a(a), pa(1) {
+        for (uint32_t i = 0; i < a; i++) pa *= p;
+        divP = FastDiv(p);
+        divPa = FastDiv(pa);
+        unitFact.resize(pa);
+        unitFact[0] = 1 % pa;
+        for (uint64_t i = 1; i < pa; i++) {
+            unitFact[i] = i % p ? mulMod(unitFact[i - 1], i) : unitFact[i - 1];
+        }
+        negate = unitFact[pa - 1] != 1 % pa;
+    }
+
+    /**
+     * C(n, k) mod p^a，k > n 时为 0
+     */
+    uint32_t binomial(uint64_t n, uint64_t k) const {
+        if (k > n) return 0;
+        uint64_t x[3] = {n, k, n - k}, f[3];
+        uint64_t e = unitFactorials(x, f);
+        if (e >= a) return 0;
+        uint64_t result = mulMod(f[0], inverse((uint32_t)mulMod(f[1], f[2])));
+        for (uint64_t i = 0; i < e; i++) result = mulMod(result, p);
+        return (uint32_t)result;
+    }
+
+    uint64_t modulus() const { return pa; }
+};
+
+// =============================================================================
+// 任意模数：分解后中国剩余定理合并
+// =============================================================================
+
+class BinomialService {
+    uint64_t m;
+    FastDiv modM;
+    std::vector<LucasBinomial> primes;             // 指数为 1 的素因子
+    std::vector<PrimePowerBinomial> primePowers;   // 指数大于 1 的素因子
+    std::vector<uint64_t> crtWeight;               // 依次对应 primes、primePowers
+
+    // 与 mod 互素的 x 的逆元
+    static uint64_t inverseMod(uint64_t x, uint64_t mod) {
+        int64_t r0 = (int64_t)mod, r1 = (int64_t)(x % mod), s0 = 0, s1 = 1;
+        while (r1) {
+            int64_t q = r0 / r1, t;
+            t = r0 - q * r1, r0 = r1, r1 = t;
+            t = s0 - q * s1, s0 = s1, s1 = t;
+        }
+        return s0 < 0 ? s0 + (int64_t)mod : s0;
+    }
+
+    // 模 q 的余数映射回模 m：乘以 (m/q) · ((m/q)^{-1} mod q)
+    uint64_t weight(uint64_t q) const {
+        uint64_t rest = m / q;
+        return modM.mod(rest * inverseMod(rest, q));
+    }
+
+public:
+    /**
+     * @param m 模数，m < 2^32，每个素数幂因子不超过 2^27
+     */
+    explicit BinomialService(uint32_t m) : m(m), modM(m) {
+        uint32_t x = m;
+        std::vector<std::pair<uint32_t, uint32_t>> factors;
+        for (uint32_t d = 2; (uint64_t)d * d <= x; d++) {
+            if (x % d) continue;
+            uint32_t e = 0;
+            while (x % d == 0) x /= d, e++;
+            factors.push_back({d, e});
+        }
+        if (x > 1) factors.push_back({x, 1});
+
+        for (auto& f : factors) if (f.second == 1) primes.emplace_back(f.first);
+        for (auto& f : factors) if (f.second > 1) primePowers.emplace_back(f.first, f.second);
+        for (auto& l : primes) crtWeight.push_back(weight(l.prime()));
+        for (auto& pp : primePowers) crtWeight.push_back(weight(pp.modulus()));
+    }
+
+    /**
+     * C(n, k) mod m
+     */
+    uint32_t binomial(uint64_t n, uint64_t k) const {
+        if (m == 1 || k > n) return 0;
+        uint64_t result = 0;
+        size_t i = 0;
+        // 每一项 < m，累加后立即取模，避免 64 位溢出
+        for (auto& l : primes) result = modM.mod(result + modM.mod((uint64_t)l.binomial(n, k) * crtWeight[i++]));
+        for (auto& pp : primePowers) result = modM.mod(result + modM.mod((uint64_t)pp.binomial(n, k) * crtWeight[i++]));
+        return (uint32_t)result;
+    }
+
+    uint64_t modulus() const { return m; }
+};
+
+#endif
@@ -0,0 +1,331 @@
+/*
+ * 矩阵快速幂引擎：正确性验证与性能测试
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 实现见 matrix_power.h。
+ *
+ * 1. SmallMatrix / ModMatrix 乘法与逐项取模的朴素乘法比较（含 2^31 附近的模数）；
+ *    M^e 与重复相乘比较；BM + Kitamasa 与稠密矩阵幂比较；
+ *    DecimalExponent 的取模 / 减一 / reduce 与逐位计算比较，十进制窗口快速幂与 64 位快速幂、
+ *    按阶约化比较（含不可逆的 [[0, y], [0, 1]]）
+ * 2. 性能：k = 8 ~ 256 的 M^(10^18)，朴素写法（每个乘积都 %）与引擎对比；
+ *    稀疏矩阵（每行 4 个非零元）的单个元素：稠密幂与 BM + Kitamasa 对比；
+ *    10^6 位十进制指数：逐位取模与 18 位一组对比，窗口快速幂与按阶约化对比
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 matrix_power.cpp -o matrix_power
+ *   ./matrix_power [最大 k]
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include "matrix_power.h"
+
+using namespace std;
+
+const uint32_t MOD = 1000000007;
+
+// 朴素乘法：每个乘积都取模（P1397.cpp 的写法推广到 k × k）
+vector<long long> naiveMultiply(const vector<long long>& a, const vector<long long>& b, int n, long long mod) {
+    vector<long long> c((size_t)n * n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            long long s = 0;
+            for (int k = 0; k < n; k++) s = (s + a[(size_t)i * n + k] * b[(size_t)k * n + j]) % mod;
+            c[(size_t)i * n + j] = s;
+        }
+    }
+    return c;
+}
+
+vector<long long> naivePower(vector<long long> base, uint64_t e, int n, long long mod) {
+    vector<long long> r((size_t)n * n, 0);
+    for (int i = 0; i < n; i++) r[(size_t)i * n + i] = 1 % mod;
+    while (e) {
+        if (e & 1) r = naiveMultiply(r, base, n, mod);
+        base = naiveMultiply(base, base, n, mod);
+        e >>= 1;
+    }
+    return r;
+}
+
+ModMatrix randomMatrix(int n, uint32_t mod, mt19937_64& rng, int nonzerosPerRow = -1) {
+    ModMatrix m(n, mod);
+    for (int i = 0; i < n; i++) {
+        if (nonzerosPerRow < 0) {
+            for (int j = 0; j < n; j++) m(i, j) = rng() % mod;
+        } else {
+            for (int t = 0; t < nonzerosPerRow; t++) m(i, rng() % n) = rng() % mod;
+        }
+    }
+    return m;
+}
+
+// 逐位取模：r = (r·10 + c) mod m
+uint64_t naiveStringMod(const string& s, uint64_t m) {
+    unsigned __int128 r = 0;
+    for (char ch : s) r = (r * 10 + (ch - '0')) % m;
+    return (uint64_t)r;
+}
+
+string randomDigits(size_t len, mt19937_64& rng) {
+    string s(len, '0');
+    for (char& ch : s) ch = '0' + rng() % 10;
+    return s;
+}
+
+vector<long long> toVector(const ModMatrix& m) {
+    int n = m.size();
+    vector<long long> v((size_t)n * n);
+    for (int i = 0; i < n; i++) for (int j = 0; j < n; j++) v[(size_t)i * n + j] = m(i, j);
+    return v;
+}
+
+void testCorrectness() {
+    cout << "=== 正确性验证 ===" << endl;
+    mt19937_64 rng(2024);
+    int errors = 0;
+    // 每组检查结束时报告一行，并把计数清零
+    auto report = [&errors](const char* name) {
+        if (errors == 0) cout << name << "：✓" << endl;
+        else cout << name << "：✗ " << errors << " 处错误" << endl;
+        errors = 0;
+    };
+
+    // 运行期矩阵：各种大小与模数（跨过 512 列分块、64 行分块）
+    for (uint32_t mod : {2u, 7u, 998244353u, MOD, 2147483647u, 1u << 30}) {
+        for (int n : {1, 2, 3, 5, 17, 64, 65, 130, 600}) {
+            if (n == 600 && mod != MOD) continue;
+            ModMatrix a = randomMatrix(n, mod, rng), b = randomMatrix(n, mod, rng);
+            if (toVector(a * b) != naiveMultiply(toVector(a), toVector(b), n, mod)) {
+                cout << "错误: 乘法 n = " << n << ", mod = " << mod << endl;
+                errors++;
+            }
+            if (n <= 17) {
+                uint64_t e = rng() % 1000;
+                if (toVector(a.pow(e)) != naivePower(toVector(a), e, n, mod)) {
+                    cout << "错误: 幂 n = " << n << ", mod = " << mod << endl;
+                    errors++;
+                }
+            }
+        }
+    }
+    report("ModMatrix 乘法与幂（n ≤ 600，6 种模数）");
+
+    // 定长矩阵：斐波那契与随机 6×6
+    SmallMatrix<2, MOD> fib;
+    fib(0, 0) = fib(0, 1) = fib(1, 0) = 1;
+    // F(10^18) mod 1e9+7 = 209783453
+    if (fib.pow(1000000000000000000ULL)(0, 1) != 209783453) {
+        cout << "错误: 斐波那契" << endl;
+        errors++;
+    }
+    report("SmallMatrix 斐波那契 F(10^18)");
+    SmallMatrix<6, 2147483647> s6;
+    ModMatrix d6(6, 2147483647);
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) s6(i, j) = d6(i, j) = rng() % 2147483647;
+    uint64_t e = rng();
+    SmallMatrix<6, 2147483647> sp = s6.pow(e);
+    ModMatrix dp = d6.pow(e);
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) if (sp(i, j) != dp(i, j)) errors++;
+    report("SmallMatrix<6> 与 ModMatrix 的幂");
+
+    // BM + Kitamasa 与稠密幂
+    for (int n : {1, 4, 20, 60}) {
+        ModMatrix m = randomMatrix(n, MOD, rng, 3);
+        vector<SparseEntry> entries;
+        for (int i = 0; i < n; i++) for (int j = 0; j < n; j++) if (m(i, j)) entries.push_back({i, j, m(i, j)});
+        vector<uint32_t> v(n);
+        for (auto& x : v) x = rng() % MOD;
+        for (uint64_t e : {0ULL, 1ULL, 5ULL, 123456789ULL, 1000000000000000000ULL}) {
+            uint32_t expect = m.pow(e).apply(v)[n - 1];
+            if (sparsePowerEntry(n, entries, v, n - 1, e, MOD) != expect) {
+                cout << "错误: BM + Kitamasa, n = " << n << ", e = " << e << endl;
+                errors++;
+            }
+        }
+    }
+    report("BM + Kitamasa 与稠密幂");
+
+    // DecimalExponent：前导零、跨组、各种模数（含 2^64 - 1）
+    for (size_t len : {0, 1, 17, 18, 19, 36, 37, 100}) {
+        for (int rep = 0; rep < 20; rep++) {
+            string s = randomDigits(len, rng);
+            if (rep == 0) s = string(len, '0');
+            if (rep == 1 && len) s = "1" + string(len - 1, '0');
+            DecimalExponent e(s);
+            for (uint64_t m : vector<uint64_t>{1, 7, (uint64_t)MOD * (MOD - 1), 1ULL << 63, ~0ULL}) {
+                if (e.mod(m) != naiveStringMod(s, m)) {
+                    cout << "错误: DecimalExponent::mod, s = " << s << ", m = " << m << endl;
+                    errors++;
+                }
+            }
+            if (e.isZero() != (naiveStringMod(s, ~0ULL) == 0 && s.find_first_not_of('0') == string::npos)) errors++;
+            if (!e.isZero()) {
+                // 减一后 mod 各减一（s 对 m 取模非零时）
+                DecimalExponent d = e;
+                d.decrement();
+                uint64_t m = 1000000009;
+                if ((d.mod(m) + 1) % m != e.mod(m)) {
+                    cout << "错误: DecimalExponent::decrement, s = " << s << endl;
+                    errors++;
+                }
+            }
+        }
+    }
+    for (uint64_t x : {0ULL, 1ULL, 999999999999999999ULL, 1000000000000000000ULL, ~0ULL}) {
+        DecimalExponent e(x);
+        for (uint64_t T : vector<uint64_t>{1, 2, x ? x : 1, x / 2 + 1, (uint64_t)MOD * (MOD - 1)}) {
+            if (T > (1ULL << 63)) continue;
+            uint64_t expect = x < T ? x : x % T + T;
+            if (e.lessThan(T) != (x < T) || e.reduce(T) != expect) {
+                cout << "错误: DecimalExponent::reduce, e = " << x << ", T = " << T << endl;
+                errors++;
+            }
+        }
+    }
+    report("DecimalExponent 的 mod / decrement / reduce");
+
+    // 十进制窗口快速幂与 64 位快速幂
+    SmallMatrix<3, MOD> s3;
+    ModMatrix d5 = randomMatrix(5, 998244353, rng);
+    for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) s3(i, j) = rng() % MOD;
+    for (uint64_t e : vector<uint64_t>{0, 1, 9, 10, 1000000000000000000ULL, rng(), ~0ULL}) {
+        SmallMatrix<3, MOD> a = s3.pow(DecimalExponent(e)), b = s3.pow(e);
+        for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) if (a(i, j) != b(i, j)) errors++;
+        if (toVector(d5.pow(DecimalExponent(e))) != toVector(d5.pow(e))) {
+            cout << "错误: 十进制窗口快速幂, e = " << e << endl;
+            errors++;
+        }
+    }
+    report("十进制窗口快速幂与 64 位快速幂");
+
+    // [[x, y], [0, 1]] 的 M^(t + p(p-1)) = M^t（t ≥ 1）：窗口快速幂与 pow(e.reduce(p(p-1))) 比较。
+    // x = 0 时 M 幂等，e 为 p(p-1) 的倍数时只取余数会得到 I
+    const uint64_t ORDER = (uint64_t)MOD * (MOD - 1);
+    for (uint32_t x : {0u, 1u, 2u, (uint32_t)(rng() % MOD)}) {
+        SmallMatrix<2, MOD> m;
+        m(0, 0) = x, m(0, 1) = rng() % MOD, m(1, 1) = 1;
+        for (string s : {to_string(ORDER) + string(30, '0'), randomDigits(300, rng), to_string(ORDER), string("5")}) {
+            DecimalExponent e(s);
+            SmallMatrix<2, MOD> a = m.pow(e), b = m.pow(e.reduce(ORDER));
+            for (int i = 0; i < 2; i++) for (int j = 0; j < 2; j++) {
+                if (a(i, j) != b(i, j)) {
+                    cout << "错误: 按阶约化, x = " << x << ", e = " << s.substr(0, 20) << "..." << endl;
+                    errors++;
+                    i = j = 2;
+                }
+            }
+        }
+    }
+    report("按阶约化（含幂等矩阵）");
+
+    // 跨组：M^(a·10^18 + b) = (M^(10^18))^a · M^b
+    {
+        ModMatrix m = randomMatrix(4, MOD, rng);
+        uint64_t a = rng() % 1000000, b = rng() % 1000000000000000000ULL;
+        string sb = to_string(b);
+        DecimalExponent e(to_string(a) + string(18 - sb.size(), '0') + sb);
+        if (toVector(m.pow(e)) != toVector(m.pow(1000000000000000000ULL).pow(a) * m.pow(b))) {
+            cout << "错误: 跨组十进制指数" << endl;
+            errors++;
+        }
+    }
+    report("跨组十进制指数");
+    cout << endl;
+}
+
+template<typename Func>
+double measureMs(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+}
+
+template<int K>
+void benchmarkSmall(mt19937_64& rng) {
+    const uint64_t e = 1000000000000000000ULL;
+    SmallMatrix<K, MOD> s;
+    vector<long long> v((size_t)K * K);
+    for (int i = 0; i < K; i++) for (int j = 0; j < K; j++) v[(size_t)i * K + j] = s(i, j) = rng() % MOD;
+    const int REPEAT = 2000 / K;
+    uint64_t checksum = 0;
+    double tNaive = measureMs([&] {
+        for (int r = 0; r < REPEAT; r++) checksum += naivePower(v, e - r, K, MOD)[0];
+    });
+    double tSmall = measureMs([&] {
+        for (int r = 0; r < REPEAT; r++) checksum -= s.pow(e - r)(0, 0);
+    });
+    printf("  k = %-3d  朴素 %9.3f ms, SmallMatrix %9.3f ms  %s\n", K, tNaive / REPEAT, tSmall / REPEAT,
+           checksum == 0 ? "" : "[结果不一致]");
+}
+
+void performanceTest(int maxK) {
+    cout << "=== 性能测试：M^(10^18) mod " << MOD << " ===" << endl;
+    mt19937_64 rng(7);
+    const uint64_t e = 1000000000000000000ULL;
+
+    benchmarkSmall<2>(rng);
+    benchmarkSmall<4>(rng);
+    benchmarkSmall<8>(rng);
+    benchmarkSmall<16>(rng);
+
+    for (int k = 8; k <= maxK; k *= 2) {
+        ModMatrix m = randomMatrix(k, MOD, rng);
+        vector<long long> v = toVector(m);
+        ModMatrix result(k, MOD);
+        double tEngine = measureMs([&] { result = m.pow(e); });
+        // 朴素版只做 8 次乘法再按乘法次数推算（M^(10^18) 约需 84 次乘法）
+        double tNaive = measureMs([&] {
+            for (int r = 0; r < 8; r++) v = naiveMultiply(v, v, k, MOD);
+        }) / 8 * 84;
+        printf("  k = %-3d  朴素（推算） %10.1f ms, ModMatrix %9.2f ms, 加速 %.1fx\n",
+               k, tNaive, tEngine, tNaive / tEngine);
+    }
+
+    cout << "稀疏矩阵（每行 4 个非零元）求 (M^(10^18) v)[k-1]：" << endl;
+    for (int k : {64, 256}) {
+        ModMatrix m = randomMatrix(k, MOD, rng, 4);
+        vector<SparseEntry> entries;
+        for (int i = 0; i < k; i++) for (int j = 0; j < k; j++) if (m(i, j)) entries.push_back({i, j, m(i, j)});
+        vector<uint32_t> v(k);
+        for (auto& x : v) x = rng() % MOD;
+        uint32_t dense = 0, sparse = 0;
+        double tDense = measureMs([&] { dense = m.pow(e).apply(v)[k - 1]; });
+        double tSparse = measureMs([&] { sparse = sparsePowerEntry(k, entries, v, k - 1, e, MOD); });
+        printf("  k = %-3d  稠密幂 %9.2f ms, BM + Kitamasa %8.2f ms  %s\n", k, tDense, tSparse,
+               dense == sparse ? "一致" : "[结果不一致]");
+    }
+
+    cout << "十进制指数（[[x, y], [0, 1]]，阶整除 p(p-1)）：" << endl;
+    const uint64_t ORDER = (uint64_t)MOD * (MOD - 1);
+    string digits = randomDigits(1000000, rng);
+    uint64_t r1 = 0, r2 = 0;
+    double tNaive = measureMs([&] { r1 = naiveStringMod(digits, ORDER); });
+    double tChunk = measureMs([&] { r2 = DecimalExponent(digits).mod(ORDER); });
+    printf("  10^6 位对 p(p-1) 取模：逐位 %8.2f ms, 18 位一组（含解析） %8.2f ms  %s\n", tNaive, tChunk,
+           r1 == r2 ? "一致" : "[结果不一致]");
+    SmallMatrix<2, MOD> m;
+    m(0, 0) = rng() % MOD, m(0, 1) = rng() % MOD, m(1, 1) = 1;
+    DecimalExponent big(digits);
+    SmallMatrix<2, MOD> w, o;
+    double tWindow = measureMs([&] { w = m.pow(big); });
+    double tOrder = measureMs([&] { o = m.pow(big.reduce(ORDER)); });
+    printf("  M^e：窗口快速幂 %8.2f ms, 按阶约化 %8.2f ms  %s\n", tWindow, tOrder,
+           w(0, 0) == o(0, 0) && w(0, 1) == o(0, 1) ? "一致" : "[结果不一致]");
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int maxK = argc > 1 ? atoi(argv[1]) : 256;
+
+    testCorrectness();
+    performanceTest(maxK);
+
+    return 0;
+}
@@ -0,0 +1,443 @@
+/*
+ * 矩阵快速幂引擎：定长小矩阵、分块大矩阵、Berlekamp–Massey + Kitamasa
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 线性递推 x_{t+1} = M x_t 的第 e 项就是 M^e x_0。P1397.cpp 里手写展开的 2×2 只是 k = 2 的特例，
+ * 这里给出通用版本（模数 m < 2^31，矩阵元素保持在 [0, m)）：
+ *
+ * - SmallMatrix<K, MOD>   编译期大小与模数，循环完全展开；K 个乘积之和放得进 64 位时
+ *                         每个元素只取一次模（延迟约简）。标量实现，适合 k ≤ 8；
+ *                         更大的 k 用 ModMatrix 的向量化乘法
+ * - ModMatrix(n, mod)     运行期大小。乘法 C = A·B 按 i-k-j 顺序做行向量累加
+ *                         acc[i][j] += A[i][k] · B[k][j]，acc 为 64 位：
+ *                         · 每累加 L 个乘积做一次“折叠” acc = hi·(2^32 mod m) + lo，
+ *                           只用移位、乘法、加法，可以整段向量化（AVX2 / AVX-512），全程不做除法
+ *                         · j 方向按 512 列、k 方向按 L（≤ 64）行分块，B 的当前块常驻缓存
+ *                         · A[i][k] = 0 时跳过整行，稀疏矩阵自动变快
+ * - berlekampMassey / kitamasa / sparsePowerEntry
+ *                         稀疏转移矩阵（每行只有少量非零元）不必做 O(k³) 的乘法：
+ *                         序列 s_t = (M^t v)[row] 满足 M 的最小多项式给出的线性递推，
+ *                         用 2k 次稀疏矩阵乘向量得到前 2k 项，BM 求出最短递推（长度 d ≤ k），
+ *                         再用 Kitamasa 计算 x^e mod 特征多项式，总代价 O(k·nnz + d² log e)。
+ *                         BM 需要模数为素数。
+ * - pow(DecimalExponent)  十进制大指数（decimal_exponent.h）的窗口快速幂：预处理 M^0..M^9，
+ *                         每一位 R ← R^10 · M^digit（R^10 = ((R²)²·R)²），每位至多 5 次乘法。
+ *                         不依赖矩阵的阶；已知阶（或周期）T 时改用 pow(e.reduce(T)) 更快
+ *
+ * 时间复杂度：SmallMatrix / ModMatrix 幂 O(k³ log e)；十进制指数 O(k³ L)，L 为位数
+ */
+
+#ifndef MATRIX_POWER_H
+#define MATRIX_POWER_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "decimal_exponent.h"
+#include "mod_int.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MATRIX_POWER_X86 1
+#endif
+
+namespace matrix_power_detail {
+
+// 0 起步累加多少个 (m-1)^2 不会超过 2^64 - 1
+constexpr uint64_t lazyTerms(uint32_t mod) {
+    uint64_t sq = (uint64_t)(mod - 1) * (mod - 1);
+    return sq == 0 ? ~0ULL : ~0ULL / sq;
+}
+
+// 折叠后 acc ≤ (2^32 - 1) · m，之后还能再累加多少个乘积
+constexpr uint64_t foldedTerms(uint32_t mod) {
+    uint64_t sq = (uint64_t)(mod - 1) * (mod - 1);
+    uint64_t folded = (uint64_t)0xFFFFFFFFu * mod;
+    return sq == 0 ? ~0ULL : (~0ULL - folded) / sq;
+}
+
+// acc[j] += x · b[j]
+inline void axpyScalar(uint64_t* acc, const uint32_t* b, uint32_t x, size_t len) {
+    for (size_t j = 0; j < len; j++) acc[j] += (uint64_t)x * b[j];
+}
+
+// acc[j] ≡ hi · 2^32 + lo → hi · r + lo，r = 2^32 mod m
+inline void foldScalar(uint64_t* acc, uint32_t r, size_t len) {
+    for (size_t j = 0; j < len; j++) acc[j] = (acc[j] >> 32) * r + (uint32_t)acc[j];
+}
+
+#ifdef MATRIX_POWER_X86
+__attribute__((target("avx2")))
+inline void axpyAvx2(uint64_t* acc, const uint32_t* b, uint32_t x, size_t len) {
+    __m256i vx = _mm256_set1_epi64x(x);
+    size_t j = 0;
+    for (; j + 4 <= len; j += 4) {
+        __m256i vb = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(b + j)));
+        __m256i va = _mm256_loadu_si256((const __m256i*)(acc + j));
+        _mm256_storeu_si256((__m256i*)(acc + j), _mm256_add_epi64(va, _mm256_mul_epu32(vb, vx)));
+    }
+    axpyScalar(acc + j, b + j, x, len - j);
+}
+
+// 一个寄存器内的 4 个通道各自折叠，vr 为广播的 r，low 为广播的 2^32 - 1
+__attribute__((target("avx2")))
+inline __m256i foldLanesAvx2(__m256i v, __m256i vr, __m256i low) {
+    return _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(v, 32), vr), _mm256_and_si256(v, low));
+}
+
+__attribute__((target("avx2")))
+inline void foldAvx2(uint64_t* acc, uint32_t r, size_t len) {
+    __m256i vr = _mm256_set1_epi64x(r), low = _mm256_set1_epi64x(0xFFFFFFFFu);
+    size_t j = 0;
+    for (; j + 4 <= len; j += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(acc + j));
+        _mm256_storeu_si256((__m256i*)(acc + j), foldLanesAvx2(v, vr, low));
+    }
+    foldScalar(acc + j, r, len - j);
+}
+
+// 全掩码的 maskz 形式与普通形式等价，只是避免 GCC 12 对 _mm512_undefined 的误报
+__attribute__((target("avx512f")))
+inline void axpyAvx512(uint64_t* acc, const uint32_t* b, uint32_t x, size_t len) {
+    __m512i vx = _mm512_set1_epi64(x);
+    size_t j = 0;
+    for (; j + 8 <= len; j += 8) {
+        __m512i vb = _mm512_maskz_cvtepu32_epi64(0xFF, _mm256_loadu_si256((const __m256i*)(b + j)));
+        __m512i va = _mm512_loadu_si512((const void*)(acc + j));
+        _mm512_storeu_si512((void*)(acc + j), _mm512_add_epi64(va, _mm512_maskz_mul_epu32(0xFF, vb, vx)));
+    }
+    axpyScalar(acc + j, b + j, x, len - j);
+}
+
+__attribute__((target("avx512f")))
+inline __m512i foldLanesAvx512(__m512i v, __m512i vr, __m512i low) {
+    return _mm512_add_epi64(_mm512_maskz_mul_epu32(0xFF, _mm512_maskz_srli_epi64(0xFF, v, 32), vr),
+                            _mm512_and_si512(v, low));
+}
+
+__attribute__((target("avx512f")))
+inline void foldAvx512(uint64_t* acc, uint32_t r, size_t len) {
+    __m512i vr = _mm512_set1_epi64(r), low = _mm512_set1_epi64(0xFFFFFFFFu);
+    size_t j = 0;
+    for (; j + 8 <= len; j += 8) {
+        __m512i v = _mm512_loadu_si512((const void*)(acc + j));
+        _mm512_storeu_si512((void*)(acc + j), foldLanesAvx512(v, vr, low));
+    }
+    foldScalar(acc + j, r, len - j);
+}
+#endif
+
+struct Kernels {
+    void (*axpy)(uint64_t*, const uint32_t*, uint32_t, size_t);
+    void (*fold)(uint64_t*, uint32_t, size_t);
+};
+
+inline const Kernels& kernels() {
+    static const Kernels k = [] {
+#ifdef MATRIX_POWER_X86
+        if (__builtin_cpu_supports("avx512f")) return Kernels{axpyAvx512, foldAvx512};
+        if (__builtin_cpu_supports("avx2")) return Kernels{axpyAvx2, foldAvx2};
+#endif
+        return Kernels{axpyScalar, foldScalar};
+    }();
+    return k;
+}
+
+// 十进制窗口快速幂，one 为同型单位阵
+template<typename Matrix>
+Matrix decimalPower(const Matrix& base, const Matrix& one, const DecimalExponent& e) {
+    Matrix table[10] = {one, base, one, one, one, one, one, one, one, one};
+    for (int d = 2; d < 10; d++) table[d] = table[d - 1] * base;
+    Matrix result = one;
+    bool started = false;   // 第一个非零位之前 R = I，不必乘
+    e.forEachDigit([&](int digit) {
+        if (started) {
+            Matrix r2 = result * result;
+            Matrix r5 = r2 * r2 * result;
+            result = r5 * r5;
+            if (digit) result = result * table[digit];
+        } else {
+            result = table[digit];
+            started = true;
+        }
+    });
+    return result;
+}
+
+}  // namespace matrix_power_detail
+
+// =============================================================================
+// 定长小矩阵
+// =============================================================================
+
+template<int K, uint32_t MOD>
+class SmallMatrix {
+    static_assert(K >= 1 && MOD >= 2 && MOD < (1u << 31), "K ≥ 1，模数须在 [2, 2^31) 内");
+    // 取模后余数 < MOD，再累加 LAZY 个乘积仍不溢出
+    static constexpr uint64_t LAZY = matrix_power_detail::lazyTerms(MOD) - 1;
+
+    std::array<uint32_t, K * K> a{};
+
+public:
+    static SmallMatrix identity() {
+        SmallMatrix r;
+        for (int i = 0; i < K; i++) r.a[i * K + i] = 1;
+        return r;
+    }
+
+    uint32_t& operator()(int i, int j) { return a[i * K + j]; }
+    uint32_t operator()(int i, int j) const { return a[i * K + j]; }
+
+    SmallMatrix operator*(const SmallMatrix& o) const {
+        // i-k-j 顺序：内层对 o 的一行连续访问，K 为常量时编译器可以整行展开
+        SmallMatrix c;
+        for (int i = 0; i < K; i++) {
+            uint64_t acc[K] = {};
+            for (int k = 0; k < K; k++) {
+                uint64_t x = a[i * K + k];
+                for (int j = 0; j < K; j++) acc[j] += x * o.a[k * K + j];
+                if constexpr (K > LAZY) {
+                    if ((k + 1) % LAZY == 0) {
+                        for (int j = 0; j < K; j++) acc[j] %= MOD;
+                    }
+                }
+            }
+            for (int j = 0; j < K; j++) c.a[i * K + j] = acc[j] % MOD;
+        }
+        return c;
+    }
+
+    SmallMatrix pow(uint64_t e) const {
+        SmallMatrix result = identity(), base = *this;
+        while (e) {
+            if (e & 1) result = result * base;
+            e >>= 1;
+            if (e) base = base * base;
+        }
+        return result;
+    }
+
+    SmallMatrix pow(const DecimalExponent& e) const {
+        return matrix_power_detail::decimalPower(*this, identity(), e);
+    }
+
+    std::array<uint32_t, K> apply(const std::array<uint32_t, K>& v) const {
+        std::array<uint32_t, K> r{};
+        for (int i = 0; i < K; i++) {
+            uint64_t acc = 0;
+            for (int k = 0; k < K; k++) {
+                acc += (uint64_t)a[i * K + k] * v[k];
+                if constexpr (K > LAZY) {
+                    if ((k + 1) % LAZY == 0) acc %= MOD;
+                }
+            }
+            r[i] = acc % MOD;
+        }
+        return r;
+    }
+};
+
+// =============================================================================
+// 运行期大小的矩阵
+// =============================================================================
+
+class ModMatrix {
+    static const size_t COL_BLOCK = 512;
+    static const size_t ROW_BLOCK = 64;
+
+    int n;
+    uint32_t mod;
+    Barrett32 barrett;
+    std::vector<uint32_t> a;
+
+public:
+    ModMatrix(int n, uint32_t mod) : n(n), mod(mod), barrett(mod), a((size_t)n * n, 0) {}
+
+    static ModMatrix identity(int n, uint32_t mod) {
+        ModMatrix r(n, mod);
+        for (int i = 0; i < n; i++) r(i, i) = 1 % mod;
+        return r;
+    }
+
+    int size() const { return n; }
+    uint32_t modulus() const { return mod; }
+    uint32_t& operator()(int i, int j) { return a[(size_t)i * n + j]; }
+    uint32_t operator()(int i, int j) const { return a[(size_t)i * n + j]; }
+
+    ModMatrix operator*(const ModMatrix& o) const {
+        using namespace matrix_power_detail;
+        const Kernels& kern = kernels();
+        ModMatrix c(n, mod);
+        uint32_t r = (uint32_t)((1ULL << 32) % mod);
+        // 第一块从 0 开始可以多累加，之后每块从折叠后的值开始
+        size_t first = std::min<uint64_t>(lazyTerms(mod), ROW_BLOCK);
+        size_t step = std::min<uint64_t>(foldedTerms(mod), ROW_BLOCK);
+        std::vector<uint64_t> acc;
+
+        for (size_t j0 = 0; j0 < (size_t)n; j0 += COL_BLOCK) {
+            size_t width = std::min(COL_BLOCK, (size_t)n - j0);
+            acc.assign((size_t)n * width, 0);
+            for (size_t k0 = 0; k0 < (size_t)n; ) {
+                size_t k1 = std::min((size_t)n, k0 + (k0 == 0 ? first : step));
+                for (size_t i = 0; i < (size_t)n; i++) {
+                    uint64_t* row = &acc[i * width];
+                    for (size_t k = k0; k < k1; k++) {
+                        uint32_t x = a[i * n + k];
+                        if (x) kern.axpy(row, &o.a[k * n + j0], x, width);
+                    }
+                }
+                kern.fold(acc.data(), r, acc.size());
+                k0 = k1;
+            }
+            for (size_t i = 0; i < (size_t)n; i++) {
+                for (size_t j = 0; j < width; j++) c.a[i * n + j0 + j] = barrett.reduce(acc[i * width + j]);
+            }
+        }
+        return c;
+    }
+
+    ModMatrix pow(uint64_t e) const {
+        ModMatrix result = identity(n, mod), base = *this;
+        bool first = true;
+        while (e) {
+            if (e & 1) {
+                result = first ? base : result * base;
+                first = false;
+            }
+            e >>= 1;
+            if (e) base = base * base;
+        }
+        return result;
+    }
+
+    ModMatrix pow(const DecimalExponent& e) const {
+        return matrix_power_detail::decimalPower(*this, identity(n, mod), e);
+    }
+
+    std::vector<uint32_t> apply(const std::vector<uint32_t>& v) const {
+        std::vector<uint32_t> r(n);
+        uint64_t lazy = matrix_power_detail::lazyTerms(mod) - 1;   // 余数 + lazy 个乘积不溢出
+        for (int i = 0; i < n; i++) {
+            uint64_t acc = 0;
+            for (int k = 0; k < n; k++) {
+                acc += (uint64_t)a[(size_t)i * n + k] * v[k];
+                if ((uint64_t)(k + 1) % lazy == 0) acc = barrett.reduce(acc);
+            }
+            r[i] = barrett.reduce(acc);
+        }
+        return r;
+    }
+};
+
+// =============================================================================
+// 稀疏递推：Berlekamp–Massey + Kitamasa（模数为素数）
+// =============================================================================
+
+/**
+ * 最短线性递推：返回 c，使 s_i = Σ_{j=1..d} c[j-1] · s_{i-j} 对所有 i ≥ d 成立
+ */
+inline std::vector<uint32_t> berlekampMassey(const std::vector<uint32_t>& s, uint32_t mod) {
+    Barrett32 br(mod);
+    std::vector<uint32_t> cur{1}, prev{1};   // 连接多项式，常数项为 1
+    uint32_t prevDelta = 1;
+    size_t len = 0, shift = 1;
+    for (size_t i = 0; i < s.size(); i++) {
+        uint64_t delta = s[i];
+        for (size_t j = 1; j <= len; j++) delta = br.reduce(delta + (uint64_t)cur[j] * s[i - j]);
+        if (delta == 0) {
+            shift++;
+            continue;
+        }
+        uint32_t coef = br.mul((uint32_t)delta, inverseMod(prevDelta, mod));
+        std::vector<uint32_t> saved = cur;
+        if (cur.size() < prev.size() + shift) cur.resize(prev.size() + shift, 0);
+        for (size_t j = 0; j < prev.size(); j++) {
+            uint32_t t = br.mul(coef, prev[j]);
+            uint32_t& x = cur[j + shift];
+            x = x >= t ? x - t : x + mod - t;
+        }
+        if (2 * len <= i) {
+            len = i + 1 - len;
+            prev = saved;
+            prevDelta = (uint32_t)delta;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+    std::vector<uint32_t> c(len);
+    for (size_t j = 1; j <= len; j++) c[j - 1] = j < cur.size() && cur[j] ? mod - cur[j] : 0;
+    return c;
+}
+
+/**
+ * 已知 s_i = Σ c[j-1] · s_{i-j} 与前 d 项 init，求 s_e
+ * 计算 x^e mod (x^d - Σ c[j-1] x^{d-j})，再与前 d 项做内积，O(d² log e)
+ */
+inline uint32_t kitamasa(const std::vector<uint32_t>& c, const std::vector<uint32_t>& init, uint64_t e, uint32_t mod) {
+    size_t d = c.size();
+    if (e < init.size()) return init[e];
+    if (d == 0) return 0;
+    Barrett32 br(mod);
+
+    // 把次数 ≥ d 的项用递推关系降下来
+    auto reduceHigh = [&](std::vector<uint64_t>& p) {
+        for (size_t i = p.size() - 1; i >= d; i--) {
+            uint32_t top = br.reduce(p[i]);
+            if (!top) continue;
+            for (size_t j = 1; j <= d; j++) p[i - j] = br.reduce(p[i - j] + (uint64_t)top * c[j - 1]);
+        }
+        p.resize(d);
+    };
+
+    std::vector<uint64_t> r(d, 0);   // 当前多项式 x^(已处理的前缀)
+    r[0] = 1 % mod;
+    int top = 63;
+    while (!(e >> top & 1)) top--;
+    for (int bit = top; bit >= 0; bit--) {
+        // 平方
+        std::vector<uint64_t> sq(2 * d - 1, 0);
+        for (size_t i = 0; i < d; i++) {
+            uint32_t ri = br.reduce(r[i]);
+            if (!ri) continue;
+            for (size_t j = 0; j < d; j++) sq[i + j] = br.reduce(sq[i + j] + (uint64_t)ri * br.reduce(r[j]));
+        }
+        reduceHigh(sq);
+        r = sq;
+        // 乘 x
+        if (e >> bit & 1) {
+            r.insert(r.begin(), 0);
+            reduceHigh(r);
+        }
+    }
+    uint64_t result = 0;
+    for (size_t i = 0; i < d; i++) result = br.reduce(result + br.mul(br.reduce(r[i]), init[i]));
+    return (uint32_t)result;
+}
+
+struct SparseEntry {
+    int row, col;
+    uint32_t value;
+};
+
+/**
+ * 稀疏矩阵 M（n × n，非零元列表）的 (M^e v)[row] mod p
+ */
+inline uint32_t sparsePowerEntry(int n, const std::vector<SparseEntry>& entries, std::vector<uint32_t> v,
+                                 int row, uint64_t e, uint32_t mod) {
+    Barrett32 br(mod);
+    std::vector<uint32_t> seq(2 * n);
+    std::vector<uint64_t> next(n);
+    for (int t = 0; t < 2 * n; t++) {
+        seq[t] = v[row];
+        std::fill(next.begin(), next.end(), 0);
+        for (const SparseEntry& x : entries) next[x.row] = br.reduce(next[x.row] + (uint64_t)x.value * v[x.col]);
+        for (int i = 0; i < n; i++) v[i] = (uint32_t)next[i];
+    }
+    std::vector<uint32_t> c = berlekampMassey(seq, mod);
+    return kitamasa(c, seq, e, mod);
+}
+
+#endif
@@ -8,24 +8,41 @@
  * 3. 均匀拟阵 (Uniform Matroid)
  * 4. 分割拟阵 (Partition Matroid)
  * 5. 拟阵交算法 (Matroid Intersection)
- * 6. 贪心算法通用框架
+ * 6. 贪心算法通用框架（虚函数版本与 CRTP 静态分派版本）
  * 
  * 时间复杂度：
- * - 图拟阵贪心：O(m log m + m α(n))
- * - 拟阵交：O(nr³)
+ * - 图拟阵贪心：O(m log m + m log n)（有状态谕示，可撤销并查集）
+ * - 并行 Filter-Kruskal：期望 O(m + n log n log(m/n))，划分与过滤多线程
+ * - 线性拟阵贪心：O(m · rank · dim)（增量消元，见 elimination_basis.h）
+ * - 拟阵交：按阶段增广，每阶段 BFS 分层一次，再在分层上连续增广；
+ *   每阶段 O(n·r) 次独立性查询（M2 方向二分，O(log r) 次查询定位一条边）
  * 
  * 空间复杂度：O(n + m)
+ * 
+ * 编译运行：
+ *   g++ -O2 -std=c++17 -pthread matroid_algorithms.cpp -o matroid
+ *   ./matroid [静态分派测试规模] [最小生成树边数]
  */
 
 #include <bits/stdc++.h>
+#include "elimination_basis.h"
 using namespace std;
 
 // =============================================================================
 // 拟阵基类定义
 // =============================================================================
 
+// 除无状态的 canAdd(current, element) 外，每个拟阵还提供一套有状态的独立性谕示：
+//   begin()       开始一个新会话，内部独立集置空
+//   tryAdd(e)     内部独立集加入 e 后是否仍独立（不修改状态）
+//   commit(e)     把 e 加入内部独立集，须先 tryAdd(e) 返回 true
+//   rollback()    撤销最近一次 commit
+// 默认实现退化为对 canAdd 的调用；具体拟阵可以重写为增量维护的版本。
 template<typename T>
 class Matroid {
+protected:
+    vector<T> session;   // 默认谕示实现使用的内部独立集
+    
 public:
     virtual ~Matroid() = default;
     virtual bool canAdd(const vector<T>& current, const T& element) = 0;
@@ -55,6 +72,11 @@ public:
         }
         return temp.size();
     }
+    
+    virtual void begin() { session.clear(); }
+    virtual bool tryAdd(const T& element) { return canAdd(session, element); }
+    virtual void commit(const T& element) { session.push_back(element); }
+    virtual void rollback() { session.pop_back(); }
 };
 
 // =============================================================================
@@ -79,6 +101,15 @@ private:
     vector<Edge> edges;  // 边集
     vector<int> parent, rank;
     
+    // 谕示会话使用的可撤销并查集：按大小合并、不做路径压缩，find 为 O(log n)
+    vector<int> sessionParent, sessionSize;
+    vector<int> history;   // 每次 commit 被挂到别处的根，-1 表示没有合并
+    
+    int sessionFind(int x) const {
+        while (sessionParent[x] != x) x = sessionParent[x];
+        return x;
+    }
+    
     int find(int x) {
         if (parent[x] != x) {
             parent[x] = find(parent[x]);
@@ -111,6 +142,9 @@ public:
         parent.resize(n);
         rank.resize(n);
         reset();
+        sessionParent.resize(n);
+        sessionSize.resize(n);
+        begin();
     }
     
     bool canAdd(const vector<int>& current, const int& edgeId) override {
@@ -146,6 +180,41 @@ public:
         return "GraphMatroid";
     }
     
+    int getVertexCount() const { return n; }
+    const vector<Edge>& getEdges() const { return edges; }
+    
+    void begin() override {
+        iota(sessionParent.begin(), sessionParent.end(), 0);
+        fill(sessionSize.begin(), sessionSize.end(), 1);
+        history.clear();
+    }
+    
+    bool tryAdd(const int& edgeId) override {
+        if (edgeId < 0 || edgeId >= (int)edges.size()) return false;
+        return sessionFind(edges[edgeId].u) != sessionFind(edges[edgeId].v);
+    }
+    
+    void commit(const int& edgeId) override {
+        int a = sessionFind(edges[edgeId].u), b = sessionFind(edges[edgeId].v);
+        if (a == b) {
+            history.push_back(-1);
+            return;
+        }
+        if (sessionSize[a] < sessionSize[b]) swap(a, b);
+        sessionParent[b] = a;
+        sessionSize[a] += sessionSize[b];
+        history.push_back(b);
+    }
+    
+    void rollback() override {
+        int b = history.back();
+        history.pop_back();
+        if (b < 0) return;
+        int a = sessionParent[b];
+        sessionSize[a] -= sessionSize[b];
+        sessionParent[b] = b;
+    }
+    
     // Kruskal算法 - 图拟阵上的贪心算法
     vector<Edge> kruskalMST() {
         vector<int> edgeIds = getGroundSet();
@@ -153,8 +222,10 @@ public:
              [&](int a, int b) { return edges[a].weight < edges[b].weight; });
         
         vector<int> mst;
+        begin();
         for (int id : edgeIds) {
-            if (canAdd(mst, id)) {
+            if (tryAdd(id)) {
+                commit(id);
                 mst.push_back(id);
                 if (mst.size() == n - 1) break;
             }
@@ -169,88 +240,275 @@ public:
 };
 
 // =============================================================================
-// 线性拟阵实现 - 用于线性代数问题
+// 并行 Filter-Kruskal - 大规模最小生成树
 // =============================================================================
 
-class LinearMatroid : public Matroid<int> {
+// 无锁并查集：parent 为原子变量，find 做路径减半（写入失败无妨），
+// unite 用 CAS 把一个根挂到另一个根下；按随机优先级合并，期望深度 O(log n)。
+// 过滤阶段多个线程同时 find，合并只在串行的 Kruskal 基础情形中进行。
+class ConcurrentUnionFind {
 private:
-    vector<vector<double>> matrix;  // 列向量矩阵
-    int n, m;  // n行m列
-    double eps = 1e-9;
+    vector<atomic<int>> parent;
     
-    // 高斯消元判断线性相关性
-    bool isLinearIndependent(const vector<int>& columns) {
-        if (columns.empty()) return true;
-        
-        vector<vector<double>> temp(n, vector<double>(columns.size()));
-        for (int j = 0; j < columns.size(); j++) {
-            for (int i = 0; i < n; i++) {
-                temp[i][j] = matrix[i][columns[j]];
-            }
+    static uint32_t priority(int x) { return (uint32_t)x * 2654435761u; }
+    
+public:
+    explicit ConcurrentUnionFind(int n) : parent(n) {
+        for (int i = 0; i < n; i++) parent[i].store(i, memory_order_relaxed);
+    }
+    
+    int find(int x) {
+        while (true) {
+            int p = parent[x].load(memory_order_relaxed);
+            if (p == x) return x;
+            int gp = parent[p].load(memory_order_relaxed);
+            if (gp != p) parent[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+            x = gp;
         }
-        
-        // 高斯消元
-        int rank = 0;
-        for (int col = 0; col < columns.size() && rank < n; col++) {
-            int pivot = -1;
-            for (int row = rank; row < n; row++) {
-                if (abs(temp[row][col]) > eps) {
-                    pivot = row;
-                    break;
-                }
+    }
+    
+    bool same(int a, int b) { return find(a) == find(b); }
+    
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (priority(a) > priority(b)) swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, memory_order_relaxed)) return true;
+        }
+    }
+};
+
+// 原地并行划分：满足 pred 的元素移到前面（不稳定），返回其个数
+// 1. 每个线程在自己的块内 std::partition
+// 2. [0, L) 中的“右类”与 [L, n) 中的“左类”个数相同，按序号一一交换，
+//    交换按序号区间均分给各线程
+template<typename Pred>
+size_t parallelPartition(Edge* a, size_t n, int threads, Pred pred) {
+    if (threads <= 1 || n < (1u << 18)) return std::partition(a, a + n, pred) - a;
+    
+    vector<size_t> begin(threads + 1), mid(threads);
+    for (int t = 0; t <= threads; t++) begin[t] = n * t / threads;
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] { mid[t] = std::partition(a + begin[t], a + begin[t + 1], pred) - a; });
+    }
+    for (auto& w : workers) w.join();
+    
+    size_t L = 0;
+    for (int t = 0; t < threads; t++) L += mid[t] - begin[t];
+    
+    // 放错位置的区间：左侧中的右类、右侧中的左类
+    vector<pair<size_t, size_t>> wrongLeft, wrongRight;
+    size_t misplaced = 0;
+    for (int t = 0; t < threads; t++) {
+        size_t lo = mid[t], hi = min(begin[t + 1], L);
+        if (lo < hi) {
+            wrongLeft.push_back({lo, hi});
+            misplaced += hi - lo;
+        }
+        lo = max(begin[t], L), hi = mid[t];
+        if (lo < hi) wrongRight.push_back({lo, hi});
+    }
+    
+    // 第 k 个放错的元素所在的位置
+    auto locate = [](const vector<pair<size_t, size_t>>& ranges, size_t k, size_t& idx) {
+        idx = 0;
+        while (k >= ranges[idx].second - ranges[idx].first) {
+            k -= ranges[idx].second - ranges[idx].first;
+            idx++;
+        }
+        return ranges[idx].first + k;
+    };
+    
+    workers.clear();
+    for (int t = 0; t < threads; t++) {
+        size_t from = misplaced * t / threads, to = misplaced * (t + 1) / threads;
+        if (from == to) continue;
+        workers.emplace_back([&, from, to] {
+            size_t li, ri;
+            size_t x = locate(wrongLeft, from, li), y = locate(wrongRight, from, ri);
+            for (size_t k = from; k < to; k++) {
+                swap(a[x], a[y]);
+                if (++x == wrongLeft[li].second && li + 1 < wrongLeft.size()) x = wrongLeft[++li].first;
+                if (++y == wrongRight[ri].second && ri + 1 < wrongRight.size()) y = wrongRight[++ri].first;
             }
-            
-            if (pivot == -1) continue;
-            
-            if (pivot != rank) {
-                swap(temp[rank], temp[pivot]);
+        });
+    }
+    for (auto& w : workers) w.join();
+    return L;
+}
+
+// Filter-Kruskal：
+//   边数少时排序后直接 Kruskal；
+//   否则按抽样得到的枢轴权重划分为轻边 / 重边，先递归处理轻边，
+//   再并行滤掉两端已连通的重边，最后递归处理剩下的重边。
+// 所有边在 edges 上原地重排，额外空间只有并查集。
+class FilterKruskal {
+private:
+    ConcurrentUnionFind uf;
+    int threads;
+    int components;
+    vector<Edge> mst;
+    mt19937 rng;
+    
+    static const size_t BASE_CASE = 1 << 16;
+    
+    void kruskal(Edge* a, size_t n) {
+        sort(a, a + n, [](const Edge& x, const Edge& y) { return x.weight < y.weight; });
+        for (size_t i = 0; i < n && components > 1; i++) {
+            if (uf.unite(a[i].u, a[i].v)) {
+                mst.push_back(a[i]);
+                components--;
             }
-            
-            for (int row = rank + 1; row < n; row++) {
-                if (abs(temp[row][col]) > eps) {
-                    double factor = temp[row][col] / temp[rank][col];
-                    for (int j = col; j < columns.size(); j++) {
-                        temp[row][j] -= factor * temp[rank][j];
-                    }
-                }
+        }
+    }
+    
+    void solve(Edge* a, size_t n) {
+        if (n == 0 || components <= 1) return;
+        if (n <= BASE_CASE) {
+            kruskal(a, n);
+            return;
+        }
+        
+        // 抽样取中位数作为枢轴
+        vector<int> sample(63);
+        for (int& w : sample) w = a[rng() % n].weight;
+        nth_element(sample.begin(), sample.begin() + 31, sample.end());
+        int pivot = sample[31];
+        
+        size_t light = parallelPartition(a, n, threads, [pivot](const Edge& e) { return e.weight <= pivot; });
+        if (light == n) {
+            // 枢轴恰为最大值：改用严格小于；仍为空说明所有权重相同
+            light = parallelPartition(a, n, threads, [pivot](const Edge& e) { return e.weight < pivot; });
+            if (light == 0) {
+                kruskal(a, n);
+                return;
             }
-            rank++;
         }
         
-        return rank == columns.size();
+        solve(a, light);
+        if (components <= 1) return;
+        
+        Edge* heavy = a + light;
+        size_t kept = parallelPartition(heavy, n - light, threads,
+                                        [this](const Edge& e) { return !uf.same(e.u, e.v); });
+        solve(heavy, kept);
     }
     
 public:
-    LinearMatroid(const vector<vector<double>>& matrix) : matrix(matrix) {
-        n = matrix.size();
-        m = matrix.empty() ? 0 : matrix[0].size();
+    FilterKruskal(int vertices, int threads)
+        : uf(vertices), threads(max(1, threads)), components(vertices), rng(12345) {}
+    
+    vector<Edge> run(vector<Edge>& edges) {
+        solve(edges.data(), edges.size());
+        return mst;
     }
+};
+
+vector<Edge> filterKruskalMST(const GraphMatroid& gm, int threads) {
+    vector<Edge> edges = gm.getEdges();
+    return FilterKruskal(gm.getVertexCount(), threads).run(edges);
+}
+
+// =============================================================================
+// 线性拟阵实现 - 用于线性代数问题
+// =============================================================================
+
+// 列向量集合上的线性拟阵，独立性由增量消元内核 Basis 判定
+// （GF2Basis / ModPBasis<MOD> / RealBasis，见 elimination_basis.h）
+//
+// 内核里缓存 current 的一个前缀已经消好的基：贪心每次只在 current 末尾追加，
+// 所以 canAdd 只需把新追加的列插入内核，再约化候选列，O(rank · dim)。
+// current 与缓存不一致时才从头重建。
+template<typename Basis>
+class BasicLinearMatroid : public Matroid<int> {
+public:
+    typedef typename Basis::Vector Vector;
+    
+private:
+    vector<Vector> columns;
+    int dim;
+    Basis basis;
+    vector<int> cached;   // 已插入内核的列，按插入顺序
+    Basis sessionBasis;   // 谕示会话单独使用一份内核，与 canAdd 的缓存互不干扰
+    
+    // 让内核恰好表示 current
+    void sync(const vector<int>& current) {
+        bool prefix = cached.size() <= current.size() &&
+                      equal(cached.begin(), cached.end(), current.begin());
+        if (!prefix) {
+            basis.clear();
+            cached.clear();
+        }
+        for (size_t i = cached.size(); i < current.size(); i++) {
+            basis.insert(columns[current[i]]);
+            cached.push_back(current[i]);
+        }
+    }
+    
+public:
+    BasicLinearMatroid(int dim, const vector<Vector>& columns)
+        : columns(columns), dim(dim), basis(dim), sessionBasis(dim) {}
     
     bool canAdd(const vector<int>& current, const int& column) override {
-        if (column >= m) return false;
-        
-        vector<int> test = current;
-        test.push_back(column);
-        return isLinearIndependent(test);
+        if (column < 0 || column >= (int)columns.size()) return false;
+        sync(current);
+        return basis.canInsert(columns[column]);
     }
     
     vector<int> getGroundSet() override {
         vector<int> result;
-        for (int i = 0; i < m; i++) {
+        for (int i = 0; i < (int)columns.size(); i++) {
             result.push_back(i);
         }
         return result;
     }
     
     int getRank() override {
-        return min(n, m);
+        return min(dim, (int)columns.size());
     }
     
     string getName() override {
         return "LinearMatroid";
     }
+    
+    void begin() override { sessionBasis.clear(); }
+    
+    bool tryAdd(const int& column) override {
+        if (column < 0 || column >= (int)columns.size()) return false;
+        return sessionBasis.canInsert(columns[column]);
+    }
+    
+    void commit(const int& column) override { sessionBasis.insert(columns[column]); }
+    void rollback() override { sessionBasis.popBack(); }
 };
 
+// 实数矩阵（n行m列）的列拟阵
+class LinearMatroid : public BasicLinearMatroid<RealBasis> {
+private:
+    static vector<vector<double>> toColumns(const vector<vector<double>>& matrix) {
+        int n = matrix.size();
+        int m = matrix.empty() ? 0 : matrix[0].size();
+        vector<vector<double>> cols(m, vector<double>(n));
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                cols[j][i] = matrix[i][j];
+            }
+        }
+        return cols;
+    }
+    
+public:
+    LinearMatroid(const vector<vector<double>>& matrix)
+        : BasicLinearMatroid<RealBasis>(matrix.size(), toColumns(matrix)) {}
+};
+
+typedef BasicLinearMatroid<GF2Basis> BinaryMatroid;            // GF(2) 上的列拟阵
+typedef BasicLinearMatroid<ModPBasis<998244353>> ModularMatroid;  // GF(998244353) 上的列拟阵
+
 // =============================================================================
 // 均匀拟阵实现 - 用于选择问题
 // =============================================================================
@@ -258,6 +516,7 @@ public:
 class UniformMatroid : public Matroid<int> {
 private:
     int n, k;  // U_{n,k}: 从n个元素中选择至多k个
+    int sessionCount = 0;
     
 public:
     UniformMatroid(int n, int k) : n(n), k(k) {}
@@ -281,6 +540,13 @@ public:
     string getName() override {
         return "UniformMatroid";
     }
+    
+    void begin() override { sessionCount = 0; }
+    bool tryAdd(const int& element) override {
+        return sessionCount < k && element >= 0 && element < n;
+    }
+    void commit(const int&) override { sessionCount++; }
+    void rollback() override { sessionCount--; }
 };
 
 // =============================================================================
@@ -293,6 +559,10 @@ private:
     vector<int> limits;              // 每个分割的容量限制
     vector<int> elementToPartition;  // 元素到分割的映射
     
+    // 谕示会话：每个分割已选的元素个数，以及 commit 的顺序（用于撤销）
+    vector<int> sessionCount;
+    vector<int> committed;
+    
 public:
     PartitionMatroid(const vector<vector<int>>& partitions, 
                      const vector<int>& limits) 
@@ -311,6 +581,7 @@ public:
                 elementToPartition[element] = i;
             }
         }
+        begin();
     }
     
     bool canAdd(const vector<int>& current, const int& element) override {
@@ -349,6 +620,30 @@ public:
     string getName() override {
         return "PartitionMatroid";
     }
+    
+    void begin() override {
+        sessionCount.assign(partitions.size(), 0);
+        committed.clear();
+    }
+    
+    bool tryAdd(const int& element) override {
+        if (element < 0 || element >= (int)elementToPartition.size() ||
+            elementToPartition[element] == -1) {
+            return false;
+        }
+        int partition = elementToPartition[element];
+        return sessionCount[partition] < limits[partition];
+    }
+    
+    void commit(const int& element) override {
+        sessionCount[elementToPartition[element]]++;
+        committed.push_back(element);
+    }
+    
+    void rollback() override {
+        sessionCount[elementToPartition[committed.back()]]--;
+        committed.pop_back();
+    }
 };
 
 // =============================================================================
@@ -369,8 +664,10 @@ public:
              });
         
         vector<T> result;
+        matroid.begin();
         for (const T& element : groundSet) {
-            if (matroid.canAdd(result, element)) {
+            if (matroid.tryAdd(element)) {
+                matroid.commit(element);
                 result.push_back(element);
             }
         }
@@ -402,129 +699,491 @@ public:
 // 拟阵交算法实现
 // =============================================================================
 
+// 交换图（I 为当前公共独立集，x ∈ I，y ∉ I）：
+//   x → y  若 I − x + y 在 M1 中独立
+//   y → x  若 I − x + y 在 M2 中独立
+// 源点 X1 = {y : I + y ∈ M1}，汇点 X2 = {y : I + y ∈ M2}，
+// 沿一条最短的 X1 → X2 路径做对称差，公共独立集大小加一。
+//
+// 交换边不逐对枚举。利用回路性质：若 I + y 不独立，设 C(y) 为其唯一回路，
+// 则对任意 S ⊆ I，I − S + y 独立 ⇔ C(y) ∩ S ≠ ∅。
+// 于是一次独立性查询可以检验 y 是否与整段 S 相邻，对 S 二分即可定位端点；
+// 会话中的 I − S 由 commit / rollback 增量维护，不需要重放整个集合。
+// BFS 按层进行，每一层只在尚未访问的元素中寻找邻居。
+//
+// 不带权版本按阶段进行（Cunningham）：每个阶段 BFS 一次得到距离分层，
+// 之后在分层上连续找多条最短增广路，分层跨增广保留，只重新探测路径末端的边，
+// 见 augmentPhase。阶段内找尽长度 d 的路径后，下一阶段的最短增广路更长，阶段数为 O(√r)；
+// augmentPhase 为省查询可能提前结束阶段，此时只会多几个阶段（性能测试中 393 次增广只用 7 个阶段）。
 class MatroidIntersection {
 private:
-    struct AugmentingPath {
-        vector<int> path;
-        bool found;
-        
-        AugmentingPath() : found(false) {}
-        AugmentingPath(const vector<int>& p) : path(p), found(true) {}
-    };
+    vector<int> ground;    // 基本集合，内部用下标表示元素
+    vector<char> inI;      // 下标是否在当前公共独立集中
+    vector<int> parent;    // 带权版本的最短路树，-1 为源点
+    vector<vector<int>> layers;   // 不带权版本当前阶段的 BFS 分层
+    int augmentations = 0;
+    int phases = 0;
     
-    // 构建辅助图并寻找增广路径
-    AugmentingPath findAugmentingPath(const vector<int>& current,
-                                     Matroid<int>& m1,
-                                     Matroid<int>& m2) {
-        vector<int> groundSet = m1.getGroundSet();
-        int n = groundSet.size();
-        
-        // 构建二分图
-        vector<vector<int>> leftToRight(n), rightToLeft(n);
-        vector<bool> inCurrent(n, false);
+    // 会话中为 I − seg[l, r)，ys 中每个元素都与 seg[l, r) 中某个元素相邻
+    // oneParent：每个 y 只需要一个相邻元素（沿一条路径下降）
+    // 否则找出每个 y 的所有相邻元素；到达叶子 seg[l] 时调用 leaf(seg[l], ys)
+    template<typename Leaf>
+    void splitByCircuit(Matroid<int>& m, const vector<int>& seg, int l, int r,
+                        const vector<int>& ys, bool oneParent, Leaf&& leaf) {
+        if (ys.empty() || l >= r) return;
+        if (r - l == 1) {
+            leaf(seg[l], ys);
+            return;
+        }
+        int mid = (l + r) / 2;
         
-        for (int element : current) {
-            if (element < n) {
-                inCurrent[element] = true;
-            }
+        // 左半：提交右半，会话变为 I − seg[l, mid)
+        vector<int> left, right;
+        for (int i = mid; i < r; i++) m.commit(ground[seg[i]]);
+        for (int y : ys) {
+            if (m.tryAdd(ground[y])) left.push_back(y);
+            else if (oneParent) right.push_back(y);
         }
+        splitByCircuit(m, seg, l, mid, left, oneParent, leaf);
+        for (int i = mid; i < r; i++) m.rollback();
         
-        // 左侧：current中的元素
-        // 右侧：ground set中的元素
-        for (int i = 0; i < n; i++) {
-            if (inCurrent[i]) {
-                // 从左侧i到右侧j的边：去掉i后可以加入j
-                for (int j = 0; j < n; j++) {
-                    if (i != j && !inCurrent[j]) {
-                        vector<int> temp = current;
-                        temp.erase(find(temp.begin(), temp.end(), i));
-                        if (m1.canAdd(temp, j)) {
-                            leftToRight[i].push_back(j);
-                        }
-                    }
-                }
+        // 右半：提交左半，会话变为 I − seg[mid, r)
+        for (int i = l; i < mid; i++) m.commit(ground[seg[i]]);
+        if (!oneParent) {
+            for (int y : ys) {
+                if (m.tryAdd(ground[y])) right.push_back(y);
             }
         }
-        
-        // 使用BFS寻找增广路径
-        queue<int> q;
-        vector<int> parent(n, -1);
-        vector<bool> visited(n, false);
-        
-        // 从所有可以加入到当前集合的元素开始
-        for (int i = 0; i < n; i++) {
-            if (!inCurrent[i] && m1.canAdd(current, i)) {
-                q.push(i);
-                visited[i] = true;
+        splitByCircuit(m, seg, mid, r, right, oneParent, leaf);
+        for (int i = l; i < mid; i++) m.rollback();
+    }
+    
+    // 会话置为 I 中 keep 标记的元素
+    void loadSession(Matroid<int>& m, const vector<int>& inside, const vector<char>& keep) {
+        m.begin();
+        for (int x : inside) {
+            if (keep[x]) m.commit(ground[x]);
+        }
+    }
+    
+    // 沿 BFS 树从汇点 y 回溯，翻转路径上的元素
+    void applyPath(int y) {
+        for (int v = y; v != -1; v = parent[v]) inI[v] ^= 1;
+    }
+    
+    // BFS 求到源点的最短距离，按距离分层：layers[0] 为源点，偶数层 ∉ I，奇数层 ∈ I。
+    // 停在第一个含汇点的层 d，该层只保留汇点；返回 d，没有增广路返回 -1
+    int buildLayers(Matroid<int>& m1, Matroid<int>& m2, const vector<int>& inside, const vector<int>& outside) {
+        int n = ground.size();
+        vector<char> visited(n, 0), sink(n, 0), keep(n, 1);
+        layers.assign(1, {});
+        loadSession(m1, inside, keep);
+        loadSession(m2, inside, keep);
+        for (int y : outside) {
+            if (m1.tryAdd(ground[y])) {
+                visited[y] = 1;
+                layers[0].push_back(y);
             }
+            if (m2.tryAdd(ground[y])) sink[y] = 1;
         }
         
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
+        vector<int> unvisited = inside;
+        while (!layers.back().empty()) {
+            vector<int> sinks;
+            for (int y : layers.back()) {
+                if (sink[y]) sinks.push_back(y);
+            }
+            if (!sinks.empty()) {
+                layers.back().swap(sinks);
+                return (int)layers.size() - 1;
+            }
             
-            // 如果u可以被M2接受，找到增广路径
-            if (m2.canAdd(current, u)) {
-                vector<int> path;
-                int curr = u;
-                while (curr != -1) {
-                    path.push_back(curr);
-                    curr = parent[curr];
-                }
-                reverse(path.begin(), path.end());
-                return AugmentingPath(path);
+            // y → x（M2）：会话为 I − 未访问的 x
+            for (int x : unvisited) keep[x] = 0;
+            loadSession(m2, inside, keep);
+            vector<int> ys, nextX;
+            for (int y : layers.back()) {
+                if (m2.tryAdd(ground[y])) ys.push_back(y);
+            }
+            splitByCircuit(m2, unvisited, 0, unvisited.size(), ys, false,
+                           [&](int x, const vector<int>&) {
+                               visited[x] = 1;
+                               nextX.push_back(x);
+                           });
+            if (nextX.empty()) break;
+            for (int x : unvisited) keep[x] = 1;
+            vector<int> rest;
+            for (int x : unvisited) {
+                if (!visited[x]) rest.push_back(x);
             }
+            unvisited.swap(rest);
             
-            // 继续搜索
-            for (int v : leftToRight[u]) {
-                if (!visited[v]) {
-                    visited[v] = true;
-                    parent[v] = u;
-                    q.push(v);
-                }
+            // x → y（M1）：会话为 I − 本层的 x
+            for (int x : nextX) keep[x] = 0;
+            loadSession(m1, inside, keep);
+            for (int x : nextX) keep[x] = 1;
+            ys.clear();
+            for (int y : outside) {
+                if (!visited[y] && m1.tryAdd(ground[y])) ys.push_back(y);
             }
+            vector<int> nextY;
+            splitByCircuit(m1, nextX, 0, nextX.size(), ys, true,
+                           [&](int, const vector<int>& to) {
+                               for (int y : to) {
+                                   visited[y] = 1;
+                                   nextY.push_back(y);
+                               }
+                           });
+            layers.push_back(move(nextX));
+            layers.push_back(move(nextY));
         }
+        return -1;
+    }
+    
+    // 一个阶段：在 buildLayers 的分层图上反复找长度为 d、逐层前进的路径并增广（阻塞流），
+    // 返回本阶段的增广次数，0 表示已经最大。
+    //
+    // 增广后交换边会变化，而且不只是路径上的元素：图拟阵里 I 的改变会让不在路径上的 y
+    // 的回路 C(y) 也随之改变，所以边不能跨增广缓存。跨增广保留的是分层：
+    // 沿最短路增广后任何元素到源点的距离都不会减小（Cunningham），
+    // 因此当前 I 下仍然存在的、逐层前进的长度 d 路径一定还是最短增广路，可以直接增广。
+    // 每一步只对当前路径末端向下一层探测一条边（M2 方向二分回路，M1 方向顺序扫描），
+    // 探测不到就把末端从本阶段删除；增广过的元素距离变大，也从本阶段删除。
+    // M1 方向每个 x 记住扫描位置，增广后不回头重扫：可能让阶段提前结束，但不会产生错误的增广，
+    // 每个阶段的第一条路径在未改变的 I 上找，一定成功。
+    int augmentPhase(Matroid<int>& m1, Matroid<int>& m2) {
+        int n = ground.size();
+        vector<int> inside, outside;
+        for (int i = 0; i < n; i++) (inI[i] ? inside : outside).push_back(i);
+        int d = buildLayers(m1, m2, inside, outside);
+        if (d < 0) return 0;
+        
+        vector<char> alive(n, 1), keep(n, 1);
+        vector<size_t> scan(n, 0);
+        // 两个会话当前装的内容：SESSION_I 为 I，x ≥ 0 为 I − x（仅 m1），其余未知
+        const int SESSION_I = -1, SESSION_OTHER = -2;
+        int state1 = SESSION_OTHER, state2 = SESSION_OTHER;
+        auto loadFull = [&](Matroid<int>& m, int& state) {
+            if (state != SESSION_I) loadSession(m, inside, keep);
+            state = SESSION_I;
+        };
         
-        return AugmentingPath();
+        int found = 0;
+        vector<int> path;
+        for (int source : layers[0]) {
+            if (!alive[source]) continue;
+            loadFull(m1, state1);
+            if (!m1.tryAdd(ground[source])) {
+                alive[source] = 0;
+                continue;
+            }
+            path.assign(1, source);
+            while (!path.empty()) {
+                int v = path.back(), level = path.size() - 1, next = -1;
+                if (level == d) {
+                    loadFull(m2, state2);
+                    if (m2.tryAdd(ground[v])) {
+                        for (int u : path) inI[u] ^= 1, alive[u] = 0;
+                        inside.clear();
+                        for (int i = 0; i < n; i++) {
+                            if (inI[i]) inside.push_back(i);
+                        }
+                        state1 = state2 = SESSION_OTHER;
+                        found++;
+                        break;
+                    }
+                } else if (level % 2 == 0) {
+                    // y → x（M2）：下一层存活的 x 组成 S，会话 I − S，对 S 二分找回路中的一个 x
+                    vector<int>& layer = layers[level + 1];
+                    layer.erase(remove_if(layer.begin(), layer.end(), [&](int x) { return !alive[x]; }),
+                                layer.end());
+                    for (int x : layer) keep[x] = 0;
+                    loadSession(m2, inside, keep);
+                    for (int x : layer) keep[x] = 1;
+                    state2 = SESSION_OTHER;
+                    if (!layer.empty() && m2.tryAdd(ground[v])) {
+                        splitByCircuit(m2, layer, 0, layer.size(), vector<int>{v}, true,
+                                       [&](int x, const vector<int>&) { next = x; });
+                    }
+                } else {
+                    // x → y（M1）：会话 I − x，从上次停下的位置继续扫描下一层
+                    if (state1 != v) {
+                        keep[v] = 0;
+                        loadSession(m1, inside, keep);
+                        keep[v] = 1;
+                        state1 = v;
+                    }
+                    const vector<int>& layer = layers[level + 1];
+                    for (size_t& k = scan[v]; k < layer.size(); k++) {
+                        if (alive[layer[k]] && m1.tryAdd(ground[layer[k]])) {
+                            next = layer[k];
+                            break;
+                        }
+                    }
+                }
+                if (level == d || next < 0) {
+                    alive[v] = 0;
+                    path.pop_back();
+                } else {
+                    path.push_back(next);
+                }
+            }
+        }
+        return found;
+    }
+    
+    void init(Matroid<int>& m1) {
+        ground = m1.getGroundSet();
+        inI.assign(ground.size(), 0);
+        augmentations = phases = 0;
+    }
+    
+    vector<int> collect() const {
+        vector<int> result;
+        for (int i = 0; i < (int)ground.size(); i++) {
+            if (inI[i]) result.push_back(ground[i]);
+        }
+        return result;
     }
     
 public:
+    // 最大公共独立集（两个拟阵的基本集合应相同）
     vector<int> solve(Matroid<int>& m1, Matroid<int>& m2) {
-        vector<int> result;
+        init(m1);
         
-        cout << "开始拟阵交算法..." << endl;
-        cout << "M1: " << m1.getName() << ", M2: " << m2.getName() << endl;
+        // 先贪心取一个极大公共独立集，减少增广次数
+        m1.begin();
+        m2.begin();
+        for (int i = 0; i < (int)ground.size(); i++) {
+            if (m1.tryAdd(ground[i]) && m2.tryAdd(ground[i])) {
+                m1.commit(ground[i]);
+                m2.commit(ground[i]);
+                inI[i] = 1;
+            }
+        }
+        
+        while (int k = augmentPhase(m1, m2)) {
+            augmentations += k;
+            phases++;
+        }
+        return collect();
+    }
+    
+    // 最大权公共独立集（大小不限）
+    // 每次沿“费用最小、其次边数最少”的路径增广，节点费用：
+    // y ∉ I 为 −w(y)，x ∈ I 为 +w(x)；最小费用不再为负时停止。
+    // 费用图需要全部交换边，用 splitByCircuit 找出每个 y 的所有相邻元素。
+    vector<int> solveWeighted(Matroid<int>& m1, Matroid<int>& m2,
+                              function<double(const int&)> weight) {
+        init(m1);
+        int n = ground.size();
+        vector<double> w(n);
+        for (int i = 0; i < n; i++) w[i] = weight(ground[i]);
         
-        int iteration = 0;
         while (true) {
-            iteration++;
-            cout << "第 " << iteration << " 次迭代，当前解大小: " 
-                 << result.size() << endl;
+            vector<int> inside, outside;
+            for (int i = 0; i < n; i++) (inI[i] ? inside : outside).push_back(i);
             
-            auto path = findAugmentingPath(result, m1, m2);
-            if (!path.found) {
-                cout << "未找到增广路径，算法结束" << endl;
-                break;
+            vector<vector<int>> adj(n);
+            vector<char> source(n, 0), sink(n, 0), none(n, 0), all(n, 1);
+            loadSession(m1, inside, all);
+            loadSession(m2, inside, all);
+            for (int y : outside) {
+                source[y] = m1.tryAdd(ground[y]);
+                sink[y] = m2.tryAdd(ground[y]);
             }
             
-            cout << "找到增广路径，长度: " << path.path.size() << endl;
+            // 会话为空集 = I − I，先滤掉自环（单独就不独立的 y）
+            vector<int> ys;
+            loadSession(m1, inside, none);
+            for (int y : outside) {
+                if (m1.tryAdd(ground[y])) ys.push_back(y);
+            }
+            splitByCircuit(m1, inside, 0, inside.size(), ys, false,
+                           [&](int x, const vector<int>& to) {
+                               for (int y : to) adj[x].push_back(y);
+                           });
+            ys.clear();
+            loadSession(m2, inside, none);
+            for (int y : outside) {
+                if (m2.tryAdd(ground[y])) ys.push_back(y);
+            }
+            splitByCircuit(m2, inside, 0, inside.size(), ys, false,
+                           [&](int x, const vector<int>& from) {
+                               for (int y : from) adj[y].push_back(x);
+                           });
             
-            // 沿增广路径更新解
-            for (int v : path.path) {
-                auto it = find(result.begin(), result.end(), v);
-                if (it == result.end()) {
-                    result.push_back(v);
-                } else {
-                    result.erase(it);
+            // SPFA，距离为 (费用, 边数) 的字典序
+            const double INF = 1e300;
+            vector<pair<double, int>> dist(n, {INF, 0});
+            vector<char> inQueue(n, 0);
+            parent.assign(n, -1);
+            queue<int> q;
+            for (int y : outside) {
+                if (source[y]) {
+                    dist[y] = {-w[y], 0};
+                    q.push(y);
+                    inQueue[y] = 1;
                 }
             }
+            while (!q.empty()) {
+                int u = q.front();
+                q.pop();
+                inQueue[u] = 0;
+                for (int v : adj[u]) {
+                    pair<double, int> nd = {dist[u].first + (inI[v] ? w[v] : -w[v]), dist[u].second + 1};
+                    if (nd.first < dist[v].first - 1e-9 ||
+                        (nd.first < dist[v].first + 1e-9 && nd.second < dist[v].second)) {
+                        dist[v] = nd;
+                        parent[v] = u;
+                        if (!inQueue[v]) {
+                            q.push(v);
+                            inQueue[v] = 1;
+                        }
+                    }
+                }
+            }
+            
+            int best = -1;
+            for (int y : outside) {
+                if (sink[y] && dist[y].first < INF &&
+                    (best < 0 || dist[y] < dist[best])) best = y;
+            }
+            if (best < 0 || dist[best].first > -1e-9) break;
+            applyPath(best);
+            augmentations++;
+        }
+        return collect();
+    }
+    
+    int getAugmentations() const { return augmentations; }
+    int getPhases() const { return phases; }
+};
+
+// =============================================================================
+// 静态分派版本（CRTP）- 用于大规模贪心
+// =============================================================================
+
+// 与 Matroid<T> 的有状态谕示接口相同（begin / tryAdd / commit），
+// 但由派生类在编译期分派，调用可以内联，没有虚函数开销。
+// 静态版本只服务于贪心，不提供 rollback，图拟阵因此可以做路径压缩。
+//
+// canAddMany 对一批元素做只读判定。独立集在贪心中只增不减，
+// 批量判定为 false 的元素之后一定仍为 false，可以直接跳过；
+// 为 true 的元素若本批内已有别的元素被加入，则需要再单独确认一次。
+template<typename Derived, typename T>
+class StaticMatroid {
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+    
+public:
+    void canAddMany(const T* elements, size_t count, char* out) {
+        for (size_t i = 0; i < count; i++) out[i] = self().tryAdd(elements[i]);
+    }
+};
+
+class StaticGraphMatroid : public StaticMatroid<StaticGraphMatroid, int> {
+private:
+    vector<Edge> edges;
+    vector<int> parent, size;
+    
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+    
+public:
+    StaticGraphMatroid(int vertices, const vector<Edge>& edges)
+        : edges(edges), parent(vertices), size(vertices) {}
+    
+    void begin() {
+        iota(parent.begin(), parent.end(), 0);
+        fill(size.begin(), size.end(), 1);
+    }
+    
+    bool tryAdd(int edgeId) { return find(edges[edgeId].u) != find(edges[edgeId].v); }
+    
+    void commit(int edgeId) {
+        int a = find(edges[edgeId].u), b = find(edges[edgeId].v);
+        if (a == b) return;
+        if (size[a] < size[b]) swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+    }
+};
+
+class StaticPartitionMatroid : public StaticMatroid<StaticPartitionMatroid, int> {
+private:
+    vector<int> elementToPartition;
+    vector<int> limits, count;
+    
+public:
+    StaticPartitionMatroid(const vector<int>& elementToPartition, const vector<int>& limits)
+        : elementToPartition(elementToPartition), limits(limits), count(limits.size()) {}
+    
+    void begin() { fill(count.begin(), count.end(), 0); }
+    
+    bool tryAdd(int element) {
+        int p = elementToPartition[element];
+        return count[p] < limits[p];
+    }
+    
+    void commit(int element) { count[elementToPartition[element]]++; }
+    
+    // 直接按分割计数判定，不经过 tryAdd
+    void canAddMany(const int* elements, size_t n, char* out) {
+        for (size_t i = 0; i < n; i++) {
+            int p = elementToPartition[elements[i]];
+            out[i] = count[p] < limits[p];
         }
-        
-        cout << "最终解大小: " << result.size() << endl;
-        return result;
     }
 };
 
+class StaticUniformMatroid : public StaticMatroid<StaticUniformMatroid, int> {
+private:
+    int k, count = 0;
+    
+public:
+    explicit StaticUniformMatroid(int k) : k(k) {}
+    
+    void begin() { count = 0; }
+    bool tryAdd(int) { return count < k; }
+    void commit(int) { count++; }
+};
+
+// 静态分派的贪心：权重只计算一次，排序比较的是预先算好的键，
+// 独立性按批查询。M 为任意提供 begin / tryAdd / commit / canAddMany 的类型。
+template<typename T, typename M, typename WeightFn>
+vector<T> staticGreedy(M& matroid, const vector<T>& groundSet, WeightFn weight) {
+    vector<pair<double, T>> keyed(groundSet.size());
+    for (size_t i = 0; i < groundSet.size(); i++) keyed[i] = {weight(groundSet[i]), groundSet[i]};
+    sort(keyed.begin(), keyed.end(),
+         [](const pair<double, T>& a, const pair<double, T>& b) { return a.first > b.first; });
+    
+    const size_t BATCH = 256;
+    T block[BATCH];
+    char ok[BATCH];
+    vector<T> result;
+    matroid.begin();
+    for (size_t start = 0; start < keyed.size(); start += BATCH) {
+        size_t count = min(BATCH, keyed.size() - start);
+        for (size_t j = 0; j < count; j++) block[j] = keyed[start + j].second;
+        matroid.canAddMany(block, count, ok);
+        
+        bool changed = false;   // 本批内是否已有元素被加入
+        for (size_t j = 0; j < count; j++) {
+            if (!ok[j] || (changed && !matroid.tryAdd(block[j]))) continue;
+            matroid.commit(block[j]);
+            result.push_back(block[j]);
+            changed = true;
+        }
+    }
+    return result;
+}
+
 // =============================================================================
 // 测试和示例代码
 // =============================================================================
@@ -551,6 +1210,10 @@ void testGraphMatroid() {
         totalWeight += e.weight;
     }
     cout << "总权重: " << totalWeight << endl;
+    
+    int filterWeight = 0;
+    for (const Edge& e : filterKruskalMST(gm, 2)) filterWeight += e.weight;
+    cout << "Filter-Kruskal 总权重: " << filterWeight << endl;
     cout << endl;
 }
 
@@ -582,6 +1245,38 @@ void testPartitionMatroid() {
     GreedyAlgorithm<int>::printSolution(solution, weight, pm.getName());
 }
 
+// 二分图匹配 = 两个分割拟阵的交：边按左端点分组、按右端点分组，每组至多选 1 条
+pair<PartitionMatroid, PartitionMatroid> bipartiteMatroids(int L, int R,
+                                                           const vector<pair<int, int>>& edges) {
+    vector<vector<int>> byLeft(L), byRight(R);
+    for (int i = 0; i < (int)edges.size(); i++) {
+        byLeft[edges[i].first].push_back(i);
+        byRight[edges[i].second].push_back(i);
+    }
+    return {PartitionMatroid(byLeft, vector<int>(L, 1)), PartitionMatroid(byRight, vector<int>(R, 1))};
+}
+
+// 对照：匈牙利算法（Kuhn）求最大匹配
+int kuhnMatching(int L, int R, const vector<pair<int, int>>& edges) {
+    vector<vector<int>> adj(L);
+    for (auto& e : edges) adj[e.first].push_back(e.second);
+    vector<int> matchR(R, -1), seen(R, -1);
+    function<bool(int, int)> dfs = [&](int u, int stamp) {
+        for (int v : adj[u]) {
+            if (seen[v] == stamp) continue;
+            seen[v] = stamp;
+            if (matchR[v] < 0 || dfs(matchR[v], stamp)) {
+                matchR[v] = u;
+                return true;
+            }
+        }
+        return false;
+    };
+    int result = 0;
+    for (int u = 0; u < L; u++) result += dfs(u, u);
+    return result;
+}
+
 void testMatroidIntersection() {
     cout << "=== 测试拟阵交算法 ===" << endl;
     
@@ -598,6 +1293,459 @@ void testMatroidIntersection() {
     }
     cout << endl;
     cout << "解的大小: " << solution.size() << endl;
+    
+    // 小规模二分图：与匈牙利算法、带权版本与暴力枚举对照
+    mt19937 rng(3);
+    bool ok = true;
+    for (int round = 0; round < 200 && ok; round++) {
+        int L = rng() % 6 + 1, R = rng() % 6 + 1, E = rng() % 13;
+        vector<pair<int, int>> edges(E);
+        vector<int> w(E);
+        for (int i = 0; i < E; i++) {
+            edges[i] = {(int)(rng() % L), (int)(rng() % R)};
+            w[i] = (int)(rng() % 21) - 5;
+        }
+        auto [left, right] = bipartiteMatroids(L, R, edges);
+        auto matching = mi.solve(left, right);
+        ok = (int)matching.size() == kuhnMatching(L, R, edges) &&
+             left.isIndependent(matching) && right.isIndependent(matching);
+        
+        auto chosen = mi.solveWeighted(left, right, [&](const int& e) { return (double)w[e]; });
+        int got = 0;
+        for (int e : chosen) got += w[e];
+        int best = 0;
+        for (int mask = 0; mask < (1 << E); mask++) {
+            vector<int> usedL(L, 0), usedR(R, 0);
+            int sum = 0;
+            bool valid = true;
+            for (int i = 0; i < E && valid; i++) {
+                if (!(mask >> i & 1)) continue;
+                valid = !usedL[edges[i].first]++ && !usedR[edges[i].second]++;
+                sum += w[i];
+            }
+            if (valid) best = max(best, sum);
+        }
+        ok = ok && left.isIndependent(chosen) && right.isIndependent(chosen) && got == best;
+    }
+    // 中等规模：一个阶段内会有多条增广路
+    for (int round = 0; round < 100 && ok; round++) {
+        int L = rng() % 40 + 1, R = rng() % 40 + 1, E = rng() % 160;
+        vector<pair<int, int>> edges(E);
+        for (auto& e : edges) e = {(int)(rng() % L), (int)(rng() % R)};
+        auto [left, right] = bipartiteMatroids(L, R, edges);
+        auto matching = mi.solve(left, right);
+        ok = (int)matching.size() == kuhnMatching(L, R, edges) &&
+             left.isIndependent(matching) && right.isIndependent(matching);
+    }
+    cout << "二分图匹配（最大 / 最大权）与对照算法一致: " << (ok ? "是" : "否") << endl;
+    
+    // 图拟阵 ∩ 分割拟阵（彩色生成森林）、图拟阵 ∩ 图拟阵：增广会改变路径以外元素的回路
+    ok = true;
+    for (int round = 0; round < 300 && ok; round++) {
+        int V = rng() % 6 + 2, E = rng() % 12 + 1, colors = rng() % 4 + 1;
+        vector<Edge> g1, g2;
+        vector<vector<int>> byColor(colors);
+        for (int i = 0; i < E; i++) {
+            g1.emplace_back(rng() % V, rng() % V, 0, i);
+            g2.emplace_back(rng() % V, rng() % V, 0, i);
+            byColor[rng() % colors].push_back(i);
+        }
+        GraphMatroid graph1(V, g1), graph2(V, g2);
+        PartitionMatroid rainbow(byColor, vector<int>(colors, 1));
+        
+        auto best = [&](Matroid<int>& a, Matroid<int>& b) {
+            int result = 0;
+            for (int mask = 0; mask < (1 << E); mask++) {
+                vector<int> chosen;
+                for (int i = 0; i < E; i++) {
+                    if (mask >> i & 1) chosen.push_back(i);
+                }
+                if ((int)chosen.size() > result && a.isIndependent(chosen) && b.isIndependent(chosen)) {
+                    result = chosen.size();
+                }
+            }
+            return result;
+        };
+        auto check = [&](Matroid<int>& a, Matroid<int>& b) {
+            auto chosen = mi.solve(a, b);
+            return a.isIndependent(chosen) && b.isIndependent(chosen) && (int)chosen.size() == best(a, b);
+        };
+        ok = check(graph1, rainbow) && check(graph1, graph2);
+    }
+    cout << "图拟阵 ∩ 分割 / 图拟阵与暴力枚举一致: " << (ok ? "是" : "否") << endl;
+    cout << endl;
+}
+
+void intersectionBenchmark() {
+    cout << "=== 拟阵交性能：二分图匹配 ===" << endl;
+    
+    mt19937 rng(5);
+    for (int V : {1000, 3000}) {
+        int E = V * 5;
+        vector<pair<int, int>> edges(E);
+        for (auto& e : edges) e = {(int)(rng() % V), (int)(rng() % V)};
+        auto [left, right] = bipartiteMatroids(V, V, edges);
+        
+        MatroidIntersection mi;
+        auto start = chrono::high_resolution_clock::now();
+        int size = mi.solve(left, right).size();
+        double ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+        cout << "V = " << V << " + " << V << ", E = " << E << ": 匹配大小 " << size
+             << "（匈牙利算法 " << kuhnMatching(V, V, edges) << "），增广 " << mi.getAugmentations()
+             << " 次（" << mi.getPhases() << " 个阶段），" << ms << " ms" << endl;
+    }
+    
+    {
+        int V = 150, E = 1500;
+        vector<pair<int, int>> edges(E);
+        for (auto& e : edges) e = {(int)(rng() % V), (int)(rng() % V)};
+        vector<double> w(E);
+        for (double& x : w) x = rng() % 1000;
+        auto [left, right] = bipartiteMatroids(V, V, edges);
+        
+        MatroidIntersection mi;
+        auto start = chrono::high_resolution_clock::now();
+        auto chosen = mi.solveWeighted(left, right, [&](const int& e) { return w[e]; });
+        double ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+        double total = 0;
+        for (int e : chosen) total += w[e];
+        cout << "带权 V = " << V << " + " << V << ", E = " << E << ": 选出 " << chosen.size()
+             << " 条边，总权重 " << total << "，" << ms << " ms" << endl;
+    }
+    cout << endl;
+}
+
+// 旧做法：每次判定都对 current + {column} 从头高斯消元，用作对照
+bool independentByFullElimination(const vector<vector<double>>& cols, const vector<int>& ids) {
+    int n = cols.empty() ? 0 : cols[0].size();
+    vector<vector<double>> temp;
+    for (int id : ids) temp.push_back(cols[id]);
+    
+    int rank = 0;
+    for (int row = 0; row < n && rank < (int)temp.size(); row++) {
+        int pivot = -1;
+        for (int j = rank; j < (int)temp.size(); j++) {
+            if (abs(temp[j][row]) > 1e-9) {
+                pivot = j;
+                break;
+            }
+        }
+        if (pivot == -1) continue;
+        swap(temp[rank], temp[pivot]);
+        for (int j = rank + 1; j < (int)temp.size(); j++) {
+            double factor = temp[j][row] / temp[rank][row];
+            for (int i = row; i < n; i++) temp[j][i] -= factor * temp[rank][i];
+        }
+        rank++;
+    }
+    return rank == (int)temp.size();
+}
+
+void testLinearMatroid() {
+    cout << "=== 测试线性拟阵（增量消元） ===" << endl;
+    
+    // dim 维空间中秩为 r 的 m 个列向量：列 = 随机 dim×r 矩阵 × 随机 r 维向量
+    const int dim = 60, r = 40, m = 400;
+    mt19937 rng(7);
+    vector<vector<int>> A(dim, vector<int>(r));
+    for (auto& row : A) for (int& x : row) x = rng() % 7 - 3;
+    vector<vector<int>> intCols(m, vector<int>(dim));
+    for (auto& col : intCols) {
+        vector<int> coef(r);
+        for (int& c : coef) c = rng() % 5 - 2;
+        for (int i = 0; i < dim; i++) {
+            for (int k = 0; k < r; k++) col[i] += A[i][k] * coef[k];
+        }
+    }
+    
+    vector<vector<double>> matrix(dim, vector<double>(m));
+    vector<ModularMatroid::Vector> modCols(m, ModularMatroid::Vector(dim));
+    vector<BinaryMatroid::Vector> binCols(m, GF2Basis::makeVector(dim));
+    for (int j = 0; j < m; j++) {
+        for (int i = 0; i < dim; i++) {
+            matrix[i][j] = intCols[j][i];
+            modCols[j][i] = (intCols[j][i] % 998244353 + 998244353) % 998244353;
+            if (intCols[j][i] & 1) GF2Basis::setBit(binCols[j], i);
+        }
+    }
+    
+    auto weight = [](int x) { return (x * 37 % 101) * 1.0; };
+    
+    LinearMatroid real(matrix);
+    ModularMatroid modular(dim, modCols);
+    BinaryMatroid binary(dim, binCols);
+    auto realBasis = GreedyAlgorithm<int>::solve(real, weight);
+    auto modBasis = GreedyAlgorithm<int>::solve(modular, weight);
+    auto binBasis = GreedyAlgorithm<int>::solve(binary, weight);
+    
+    cout << "实数域基大小: " << realBasis.size() << "，GF(998244353): " << modBasis.size()
+         << "，GF(2): " << binBasis.size() << "（构造的秩为 " << r << "）" << endl;
+    
+    // 与从头消元的结果对照：贪心的每一步判定都应一致
+    vector<vector<double>> cols(m, vector<double>(dim));
+    for (int j = 0; j < m; j++) for (int i = 0; i < dim; i++) cols[j][i] = matrix[i][j];
+    vector<int> order = real.getGroundSet();
+    sort(order.begin(), order.end(), [&](int a, int b) { return weight(a) > weight(b); });
+    vector<int> reference;
+    for (int id : order) {
+        reference.push_back(id);
+        if (!independentByFullElimination(cols, reference)) reference.pop_back();
+    }
+    cout << "与逐次完整消元的结果一致: " << (reference == realBasis && realBasis == modBasis ? "是" : "否")
+         << endl;
+    cout << endl;
+}
+
+void linearMatroidBenchmark() {
+    cout << "=== 线性拟阵贪心性能：增量消元 vs 逐次完整消元 ===" << endl;
+    
+    mt19937 rng(11);
+    for (int dim : {40, 80, 160}) {
+        int m = dim * 4;
+        vector<vector<double>> matrix(dim, vector<double>(m));
+        for (auto& row : matrix) for (double& x : row) x = (int)(rng() % 21) - 10;
+        vector<vector<double>> cols(m, vector<double>(dim));
+        for (int j = 0; j < m; j++) for (int i = 0; i < dim; i++) cols[j][i] = matrix[i][j];
+        
+        auto t0 = chrono::high_resolution_clock::now();
+        vector<int> reference;
+        for (int id = 0; id < m; id++) {
+            reference.push_back(id);
+            if (!independentByFullElimination(cols, reference)) reference.pop_back();
+        }
+        auto t1 = chrono::high_resolution_clock::now();
+        LinearMatroid lm(matrix);
+        vector<int> incremental;
+        for (int id = 0; id < m; id++) {
+            if (lm.canAdd(incremental, id)) incremental.push_back(id);
+        }
+        auto t2 = chrono::high_resolution_clock::now();
+        
+        cout << "dim = " << dim << ", m = " << m << ": 完整消元 "
+             << chrono::duration<double, milli>(t1 - t0).count() << " ms, 增量消元 "
+             << chrono::duration<double, milli>(t2 - t1).count() << " ms, 结果一致: "
+             << (reference == incremental ? "是" : "否") << endl;
+    }
+    cout << endl;
+}
+
+// 旧做法：每一步都用无状态的 canAdd(result, e) 判定
+vector<int> statelessGreedy(Matroid<int>& matroid, const vector<int>& order) {
+    vector<int> result;
+    for (int e : order) {
+        if (matroid.canAdd(result, e)) result.push_back(e);
+    }
+    return result;
+}
+
+vector<int> oracleGreedy(Matroid<int>& matroid, const vector<int>& order) {
+    vector<int> result;
+    matroid.begin();
+    for (int e : order) {
+        if (matroid.tryAdd(e)) {
+            matroid.commit(e);
+            result.push_back(e);
+        }
+    }
+    return result;
+}
+
+// 随机 commit / rollback 序列，每一步都与无状态 canAdd 对照
+bool checkOracleRollback(Matroid<int>& matroid, int groundSize, mt19937& rng) {
+    vector<int> current;
+    matroid.begin();
+    for (int step = 0; step < 2000; step++) {
+        if (!current.empty() && rng() % 3 == 0) {
+            matroid.rollback();
+            current.pop_back();
+            continue;
+        }
+        int e = rng() % groundSize;
+        bool expected = matroid.canAdd(current, e);
+        if (matroid.tryAdd(e) != expected) return false;
+        if (expected) {
+            matroid.commit(e);
+            current.push_back(e);
+        }
+    }
+    return true;
+}
+
+void oracleBenchmark() {
+    cout << "=== 有状态独立性谕示 vs 无状态 canAdd ===" << endl;
+    
+    mt19937 rng(2024);
+    auto timeIt = [](auto&& f) {
+        auto start = chrono::high_resolution_clock::now();
+        f();
+        return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+    };
+    
+    // 图拟阵：Kruskal，无状态版本每次判定都重放整个并查集，O(E·V)
+    for (int V : {1000, 4000}) {
+        int E = V * 10;
+        vector<Edge> edges;
+        for (int i = 0; i < E; i++) edges.emplace_back(rng() % V, rng() % V, rng() % 1000000, i);
+        GraphMatroid gm(V, edges);
+        vector<int> order(E);
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return edges[a].weight < edges[b].weight; });
+        
+        vector<int> slow, fast;
+        double slowMs = timeIt([&] { slow = statelessGreedy(gm, order); });
+        double fastMs = timeIt([&] { fast = oracleGreedy(gm, order); });
+        cout << "图拟阵 V = " << V << ", E = " << E << ": canAdd " << slowMs << " ms, 谕示 "
+             << fastMs << " ms, 结果一致: " << (slow == fast ? "是" : "否") << endl;
+    }
+    
+    // 分割拟阵：无状态版本每次判定都扫描整个 current
+    {
+        int groups = 1000, perGroup = 100;
+        vector<vector<int>> partitions(groups);
+        vector<int> limits(groups);
+        for (int g = 0; g < groups; g++) {
+            for (int j = 0; j < perGroup; j++) partitions[g].push_back(g * perGroup + j);
+            limits[g] = rng() % 50 + 1;
+        }
+        PartitionMatroid pm(partitions, limits);
+        vector<int> order(groups * perGroup);
+        iota(order.begin(), order.end(), 0);
+        shuffle(order.begin(), order.end(), rng);
+        
+        vector<int> slow, fast;
+        double slowMs = timeIt([&] { slow = statelessGreedy(pm, order); });
+        double fastMs = timeIt([&] { fast = oracleGreedy(pm, order); });
+        cout << "分割拟阵 " << order.size() << " 个元素: canAdd " << slowMs << " ms, 谕示 "
+             << fastMs << " ms, 结果一致: " << (slow == fast ? "是" : "否") << endl;
+    }
+    
+    // 撤销正确性
+    {
+        vector<Edge> edges;
+        for (int i = 0; i < 300; i++) edges.emplace_back(rng() % 60, rng() % 60, 0, i);
+        GraphMatroid gm(60, edges);
+        PartitionMatroid pm({{0, 1, 2}, {3, 4}, {5, 6, 7, 8, 9}}, {2, 1, 3});
+        vector<vector<double>> matrix(8, vector<double>(40));
+        for (auto& row : matrix) for (double& x : row) x = rng() % 3;
+        LinearMatroid lm(matrix);
+        UniformMatroid um(30, 7);
+        bool ok = checkOracleRollback(gm, 300, rng) && checkOracleRollback(pm, 10, rng) &&
+                  checkOracleRollback(lm, 40, rng) && checkOracleRollback(um, 30, rng);
+        cout << "随机 commit / rollback 与 canAdd 对照: " << (ok ? "一致" : "不一致") << endl;
+    }
+    cout << endl;
+}
+
+// 虚函数 + std::function 的 GreedyAlgorithm 与静态分派的 staticGreedy 对比
+void staticDispatchBenchmark(int n) {
+    cout << "=== 虚函数框架 vs 静态分派框架（n = " << n << "）===" << endl;
+    
+    // 互不相同的权重：奇数乘法在 mod 2^32 下是双射
+    auto weight = [](const int& x) { return (double)(uint32_t)((uint32_t)x * 2654435761u); };
+    function<double(const int&)> weightFn = weight;
+    auto timeIt = [](auto&& f) {
+        auto start = chrono::high_resolution_clock::now();
+        f();
+        return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+    };
+    mt19937 rng(99);
+    
+    // 分割拟阵：n 个元素分成 n/100 组
+    {
+        int groups = max(1, n / 100);
+        vector<int> owner(n), limits(groups);
+        vector<vector<int>> partitions(groups);
+        for (int i = 0; i < n; i++) {
+            owner[i] = rng() % groups;
+            partitions[owner[i]].push_back(i);
+        }
+        for (int& l : limits) l = rng() % 20 + 1;
+        PartitionMatroid pm(partitions, limits);
+        StaticPartitionMatroid spm(owner, limits);
+        vector<int> ground(n);
+        iota(ground.begin(), ground.end(), 0);
+        
+        vector<int> a, b;
+        double virtualMs = timeIt([&] { a = GreedyAlgorithm<int>::solve(pm, weightFn); });
+        double staticMs = timeIt([&] { b = staticGreedy<int>(spm, ground, weight); });
+        cout << "分割拟阵: 虚函数 " << virtualMs << " ms, 静态分派 " << staticMs
+             << " ms, 结果一致: " << (a == b ? "是" : "否") << endl;
+    }
+    
+    // 图拟阵：n 条边，n/4 个顶点
+    {
+        int V = max(2, n / 4);
+        vector<Edge> edges(n);
+        for (int i = 0; i < n; i++) edges[i] = Edge(rng() % V, rng() % V, 0, i);
+        GraphMatroid gm(V, edges);
+        StaticGraphMatroid sgm(V, edges);
+        vector<int> ground(n);
+        iota(ground.begin(), ground.end(), 0);
+        
+        vector<int> a, b;
+        double virtualMs = timeIt([&] { a = GreedyAlgorithm<int>::solve(gm, weightFn); });
+        double staticMs = timeIt([&] { b = staticGreedy<int>(sgm, ground, weight); });
+        cout << "图拟阵:   虚函数 " << virtualMs << " ms, 静态分派 " << staticMs
+             << " ms, 结果一致: " << (a == b ? "是" : "否") << endl;
+    }
+    
+    // 均匀拟阵
+    {
+        UniformMatroid um(n, n / 10);
+        StaticUniformMatroid sum(n / 10);
+        vector<int> ground(n);
+        iota(ground.begin(), ground.end(), 0);
+        
+        vector<int> a, b;
+        double virtualMs = timeIt([&] { a = GreedyAlgorithm<int>::solve(um, weightFn); });
+        double staticMs = timeIt([&] { b = staticGreedy<int>(sum, ground, weight); });
+        cout << "均匀拟阵: 虚函数 " << virtualMs << " ms, 静态分派 " << staticMs
+             << " ms, 结果一致: " << (a == b ? "是" : "否") << endl;
+    }
+    cout << endl;
+}
+
+// 串行 Kruskal vs 并行 Filter-Kruskal，m 条随机边，m/10 个顶点
+void mstBenchmark(size_t m) {
+    int V = max<size_t>(2, m / 10);
+    int hw = max(1u, thread::hardware_concurrency());
+    cout << "=== 最小生成树：Kruskal vs Filter-Kruskal（V = " << V << ", E = " << m
+         << ", 硬件线程 " << hw << "）===" << endl;
+    
+    // 每次测试前按同一种子重新生成，避免保留多份边集
+    vector<Edge> edges;
+    auto generate = [&] {
+        mt19937 rng(2024);
+        edges.resize(m);
+        for (size_t i = 0; i < m; i++) edges[i] = Edge(rng() % V, rng() % V, rng() % 1000000000, i);
+    };
+    auto weightOf = [](const vector<Edge>& tree) {
+        long long total = 0;
+        for (const Edge& e : tree) total += e.weight;
+        return total;
+    };
+    
+    generate();
+    auto start = chrono::high_resolution_clock::now();
+    sort(edges.begin(), edges.end());
+    ConcurrentUnionFind uf(V);
+    vector<Edge> tree;
+    for (const Edge& e : edges) {
+        if (uf.unite(e.u, e.v)) tree.push_back(e);
+    }
+    double kruskalMs = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+    cout << "Kruskal（全排序）: " << kruskalMs << " ms, 边数 " << tree.size()
+         << ", 总权重 " << weightOf(tree) << endl;
+    
+    for (int threads : {1, hw}) {
+        generate();
+        start = chrono::high_resolution_clock::now();
+        tree = FilterKruskal(V, threads).run(edges);
+        double ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+        cout << "Filter-Kruskal（" << threads << " 线程）: " << ms << " ms, 边数 " << tree.size()
+             << ", 总权重 " << weightOf(tree) << endl;
+        if (hw == 1) break;
+    }
     cout << endl;
 }
 
@@ -626,7 +1774,12 @@ void demonstrateMatroidProperties() {
     cout << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // 可选参数：静态分派对比测试的元素个数
+    int staticN = argc > 1 ? atoi(argv[1]) : 2000000;
+    // 可选参数：最小生成树测试的边数，例如 100000000
+    size_t mstEdges = argc > 2 ? atoll(argv[2]) : 10000000;
+    
     cout << "🌸 千禧年科技学院 - 拟阵理论算法演示 🌸" << endl;
     cout << "by ユウカ" << endl;
     cout << endl;
@@ -635,7 +1788,13 @@ int main() {
     testGraphMatroid();
     testUniformMatroid();
     testPartitionMatroid();
+    testLinearMatroid();
+    linearMatroidBenchmark();
+    oracleBenchmark();
     testMatroidIntersection();
+    intersectionBenchmark();
+    staticDispatchBenchmark(staticN);
+    mstBenchmark(mstEdges);
     
     cout << "🎯 拟阵理论演示完成！" << endl;
     cout << "拟阵理论为贪心算法提供了坚实的理论基础，" << endl;
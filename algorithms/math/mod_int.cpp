@@ -0,0 +1,169 @@
+/*
+ * 模运算层：正确性验证与乘法取模性能对比
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 实现见 mod_int.h。
+ *
+ * 1. 随机运算与 long long 上直接 % 的结果逐项比较；pow / inv 与费马小定理对照；
+ *    编译期求值（static_assert）
+ * 2. 性能：总计 N 次“乘法 + 约简”（默认 10^9），4 条互不依赖的乘法链同时推进，
+ *    测的是吞吐量：
+ *    - long long % 编译期常量（P1397.cpp 的写法）
+ *    - long long % 运行期模数（64 位除法）
+ *    - ModInt<MOD>（Montgomery）
+ *    - DynamicModInt（Barrett）
+ *    - Montgomery32 运行期模数
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 mod_int.cpp -o mod_int
+ *   ./mod_int [乘法次数]
+ */
+
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "mod_int.h"
+
+using namespace std;
+
+const uint32_t MOD = 1000000007;
+typedef ModInt<MOD> Mint;
+typedef DynamicModInt<0> Dint;
+
+// 编译期求值
+static_assert(ModInt<998244353>(3).pow(998244352).val() == 1, "费马小定理");
+static_assert((ModInt<998244353>(2) * ModInt<998244353>(2).inv()).val() == 1, "逆元");
+static_assert(ModInt<1u << 30>(-1).val() == (1u << 30) - 1, "偶数模数");
+
+template<uint32_t M>
+bool checkStatic(mt19937_64& rng) {
+    typedef ModInt<M> T;
+    for (int t = 0; t < 200000; t++) {
+        int64_t a = (int64_t)(rng() >> 2) - (1LL << 61), b = (int64_t)(rng() >> 2) - (1LL << 61);
+        int64_t ra = (a % (int64_t)M + M) % M, rb = (b % (int64_t)M + M) % M;
+        T x(a), y(b);
+        if (x.val() != ra || (x + y).val() != (ra + rb) % M || (x - y).val() != (ra - rb + M) % M) return false;
+        if ((x * y).val() != (uint64_t)ra * rb % M || (-x).val() != (M - ra) % M) return false;
+    }
+    return true;
+}
+
+template<typename T>
+bool checkDynamic(uint32_t m, mt19937_64& rng) {
+    T::setMod(m);
+    for (int t = 0; t < 200000; t++) {
+        uint64_t a = rng() % m, b = rng() % m;
+        T x((int64_t)a), y((int64_t)b);
+        if ((x * y).val() != a * b % m || (x + y).val() != (a + b) % m || (x - y).val() != (a + m - b) % m) return false;
+    }
+    Montgomery32 mont(m | 1);
+    uint32_t mm = m | 1;
+    for (int t = 0; t < 200000; t++) {
+        uint32_t a = rng() % mm, b = rng() % mm;
+        if (mont.fromMont(mont.mul(mont.toMont(a), mont.toMont(b))) != (uint64_t)a * b % mm) return false;
+    }
+    return true;
+}
+
+void testCorrectness() {
+    cout << "=== 正确性验证 ===" << endl;
+    mt19937_64 rng(42);
+    auto mark = [](bool ok) { return ok ? " ✓ " : " ✗ "; };
+
+    cout << "ModInt 与 % 运算对拍：";
+    cout << "1000000007" << mark(checkStatic<1000000007>(rng));
+    cout << "998244353" << mark(checkStatic<998244353>(rng));
+    cout << "2^31-1" << mark(checkStatic<2147483647>(rng));
+    cout << "2^30" << mark(checkStatic<1u << 30>(rng));
+    cout << "19260817" << mark(checkStatic<19260817>(rng));
+    cout << "2" << mark(checkStatic<2>(rng));
+    cout << "3" << mark(checkStatic<3>(rng)) << endl;
+
+    cout << "DynamicModInt / Montgomery32 对拍：";
+    for (uint32_t m : {2u, 3u, 1000000007u, 998244353u, 2147483647u, 1u << 30, 19260817u, 1000000u}) {
+        cout << m << mark(checkDynamic<Dint>(m, rng));
+    }
+    cout << endl;
+
+    // pow / inv / 除法
+    bool prime = true, composite = true;
+    for (int t = 0; t < 1000; t++) {
+        Mint a((int64_t)(rng() % (MOD - 1) + 1));
+        prime = prime && a.pow(MOD - 1) == Mint(1) && a * a.inv() == Mint(1) && (a / a) == Mint(1);
+        Dint::setMod(1000000);   // 合数模数：只对互素的数求逆
+        Dint b((int64_t)(rng() % 1000000) | 1);
+        if (b.val() % 5 == 0) continue;
+        composite = composite && (b * b.inv()).val() == 1;
+    }
+    cout << "费马小定理、逆元与除法（模 " << MOD << "）：" << (prime ? "✓" : "✗") << endl;
+    cout << "合数模 10^6 下互素元素求逆：" << (composite ? "✓" : "✗") << endl << endl;
+}
+
+template<typename Func>
+void measure(const char* name, uint64_t ops, Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    uint64_t checksum = func();
+    double t = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    printf("  %-32s %8.3f s, %6.2f ns/次 (校验 %llu)\n", name, t, t * 1e9 / ops, (unsigned long long)checksum);
+}
+
+void performanceTest(uint64_t ops) {
+    cout << "=== 性能测试：" << ops << " 次乘法取模（模数 " << MOD << "）===" << endl;
+    uint64_t rounds = ops / 4;
+    // 运行期模数经 volatile 局部变量读出，编译器无法把它当常量
+    volatile uint32_t runtimeMod = MOD;
+    uint32_t m = runtimeMod;
+
+    measure("long long % 编译期常量", ops, [&] {
+        long long a = 2, b = 3, c = 5, d = 7;
+        const long long k = 123456789;
+        for (uint64_t i = 0; i < rounds; i++) {
+            a = a * k % MOD, b = b * k % MOD, c = c * k % MOD, d = d * k % MOD;
+        }
+        return (uint64_t)(a + b + c + d);
+    });
+
+    measure("long long % 运行期模数", ops, [&] {
+        long long a = 2, b = 3, c = 5, d = 7, mod = m;
+        const long long k = 123456789;
+        for (uint64_t i = 0; i < rounds; i++) {
+            a = a * k % mod, b = b * k % mod, c = c * k % mod, d = d * k % mod;
+        }
+        return (uint64_t)(a + b + c + d);
+    });
+
+    measure("ModInt<MOD>（Montgomery）", ops, [&] {
+        Mint a = 2, b = 3, c = 5, d = 7, k = 123456789;
+        for (uint64_t i = 0; i < rounds; i++) a *= k, b *= k, c *= k, d *= k;
+        return (uint64_t)(a + b + c + d).val();
+    });
+
+    measure("DynamicModInt（Barrett）", ops, [&] {
+        Dint::setMod(m);
+        Dint a = 2, b = 3, c = 5, d = 7, k = 123456789;
+        for (uint64_t i = 0; i < rounds; i++) a *= k, b *= k, c *= k, d *= k;
+        return (uint64_t)(a + b + c + d).val();
+    });
+
+    measure("Montgomery32 运行期模数", ops, [&] {
+        Montgomery32 mont(m);
+        uint32_t a = mont.toMont(2), b = mont.toMont(3), c = mont.toMont(5), d = mont.toMont(7);
+        uint32_t k = mont.toMont(123456789);
+        for (uint64_t i = 0; i < rounds; i++) {
+            a = mont.mul(a, k), b = mont.mul(b, k), c = mont.mul(c, k), d = mont.mul(d, k);
+        }
+        return (uint64_t)mont.fromMont(a) + mont.fromMont(b) + mont.fromMont(c) + mont.fromMont(d);
+    });
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t ops = argc > 1 ? atoll(argv[1]) : 1000000000;
+
+    testCorrectness();
+    performanceTest(ops);
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * 模运算层：Montgomery / Barrett 约简与 ModInt
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 仓库里的快速幂、矩阵幂、逐位取模（如 P1397.cpp 的 power_mod / matrix_power /
+ * string_mod）都直接对 long long 做 %。模数是运行时变量时这是一条 64 位除法，
+ * 延迟几十个周期；本文件把约简换成乘法：
+ *
+ * - Montgomery32(mod)    奇模数。值保存为 x·2^32 mod m，乘法后
+ *                        t·2^-32 = (t + ((t·(-m^-1)) mod 2^32)·m) / 2^32，只需两次乘法
+ * - Barrett32(mod)       任意模数。预存 im = ⌈2^64 / m⌉，q = ⌊t·im / 2^64⌋ 与真实商至多差 1
+ * - ModInt<MOD>          编译期模数：奇数走 Montgomery（常量全部 constexpr），
+ *                        偶数直接用常量 %（编译器会把它换成乘法）
+ * - DynamicModInt<ID>    运行期模数（Barrett），用 setMod 设置；ID 区分同时存在的不同模数
+ *
+ * 约定：模数 2 ≤ m < 2^31，所有值保持在 [0, m)。
+ * inv() 用扩展欧几里得，模数不必是素数（要求与模数互素）。
+ */
+
+#ifndef MOD_INT_H
+#define MOD_INT_H
+
+#include <cstdint>
+#include <iostream>
+
+// =============================================================================
+// 约简器
+// =============================================================================
+
+struct Montgomery32 {
+    uint32_t mod, negInv, r2;   // negInv · mod ≡ -1 (mod 2^32)，r2 = 2^64 mod m
+
+    constexpr explicit Montgomery32(uint32_t mod) : mod(mod), negInv(computeNegInv(mod)),
+        r2((uint32_t)((0 - (uint64_t)mod) % mod)) {}
+
+    // 牛顿迭代：每一步有效位数翻倍，mod 本身是 3 位精度的逆
+    static constexpr uint32_t computeNegInv(uint32_t mod) {
+        uint32_t inv = mod;
+        for (int i = 0; i < 4; i++) inv *= 2 - mod * inv;
+        return 0 - inv;
+    }
+
+    // t < mod · 2^32，返回 t · 2^-32 mod m
+    constexpr uint32_t reduce(uint64_t t) const {
+        uint32_t m = (uint32_t)t * negInv;
+        uint32_t r = (uint32_t)((t + (uint64_t)m * mod) >> 32);
+        return r >= mod ? r - mod : r;
+    }
+    constexpr uint32_t toMont(uint32_t x) const { return reduce((uint64_t)x * r2); }
+    constexpr uint32_t fromMont(uint32_t x) const { return reduce(x); }
+    constexpr uint32_t mul(uint32_t a, uint32_t b) const { return reduce((uint64_t)a * b); }
+};
+
+struct Barrett32 {
+    uint32_t mod;
+    uint64_t im;   // ⌈2^64 / m⌉
+
+    constexpr explicit Barrett32(uint32_t mod) : mod(mod), im(~0ULL / mod + 1) {}
+
+    // 返回 t mod m。q ∈ {⌊t/m⌋, ⌊t/m⌋ + 1}，q·m 不溢出即可，
+    // 所以不只是乘积，任意 t ≤ 2^64 - 1 - m 都成立（用于延迟约简的累加和）
+    constexpr uint32_t reduce(uint64_t t) const {
+        uint64_t q = (uint64_t)(((unsigned __int128)t * im) >> 64);
+        uint64_t p = q * mod;
+        return (uint32_t)(t - p + (t < p ? mod : 0));
+    }
+    constexpr uint32_t mul(uint32_t a, uint32_t b) const { return reduce((uint64_t)a * b); }
+};
+
+// 与 mod 互素的 x 的逆元
+constexpr uint32_t inverseMod(uint32_t x, uint32_t mod) {
+    int64_t r0 = mod, r1 = x, s0 = 0, s1 = 1;
+    while (r1) {
+        int64_t q = r0 / r1, t = 0;
+        t = r0 - q * r1, r0 = r1, r1 = t;
+        t = s0 - q * s1, s0 = s1, s1 = t;
+    }
+    return (uint32_t)(s0 < 0 ? s0 + mod : s0);
+}
+
+// =============================================================================
+// 编译期模数
+// =============================================================================
+
+template<uint32_t MOD>
+class ModInt {
+    static_assert(MOD >= 2 && MOD < (1u << 31), "模数须在 [2, 2^31) 内");
+
+    static constexpr bool MONTGOMERY = MOD & 1;
+    static constexpr Montgomery32 ctx{MOD | 1};
+
+    uint32_t v;   // MONTGOMERY 时为 Montgomery 形式
+
+    struct Raw {};
+    constexpr ModInt(uint32_t v, Raw) : v(v) {}
+
+    static constexpr uint32_t encode(int64_t x) {
+        int64_t r = x % (int64_t)MOD;
+        uint32_t u = (uint32_t)(r < 0 ? r + MOD : r);
+        if constexpr (MONTGOMERY) return ctx.toMont(u);
+        else return u;
+    }
+
+public:
+    constexpr ModInt() : v(0) {}
+    constexpr ModInt(int64_t x) : v(encode(x)) {}
+
+    static constexpr uint32_t mod() { return MOD; }
+    constexpr uint32_t val() const {
+        if constexpr (MONTGOMERY) return ctx.fromMont(v);
+        else return v;
+    }
+
+    constexpr ModInt& operator+=(ModInt o) {
+        v += o.v;
+        if (v >= MOD) v -= MOD;
+        return *this;
+    }
+    constexpr ModInt& operator-=(ModInt o) {
+        v = v >= o.v ? v - o.v : v + MOD - o.v;
+        return *this;
+    }
+    constexpr ModInt& operator*=(ModInt o) {
+        if constexpr (MONTGOMERY) v = ctx.mul(v, o.v);
+        else v = (uint32_t)((uint64_t)v * o.v % MOD);
+        return *this;
+    }
+    constexpr ModInt& operator/=(ModInt o) { return *this *= o.inv(); }
+
+    constexpr ModInt operator-() const { return ModInt(v ? MOD - v : 0, Raw()); }
+    friend constexpr ModInt operator+(ModInt a, ModInt b) { return a += b; }
+    friend constexpr ModInt operator-(ModInt a, ModInt b) { return a -= b; }
+    friend constexpr ModInt operator*(ModInt a, ModInt b) { return a *= b; }
+    friend constexpr ModInt operator/(ModInt a, ModInt b) { return a /= b; }
+    friend constexpr bool operator==(ModInt a, ModInt b) { return a.v == b.v; }
+    friend constexpr bool operator!=(ModInt a, ModInt b) { return a.v != b.v; }
+
+    constexpr ModInt pow(uint64_t e) const {
+        ModInt base = *this, r = 1;
+        while (e) {
+            if (e & 1) r *= base;
+            base *= base;
+            e >>= 1;
+        }
+        return r;
+    }
+    constexpr ModInt inv() const { return ModInt(inverseMod(val(), MOD)); }
+
+    friend std::ostream& operator<<(std::ostream& os, ModInt a) { return os << a.val(); }
+};
+
+// =============================================================================
+// 运行期模数
+// =============================================================================
+
+template<int ID>
+class DynamicModInt {
+    static inline Barrett32 ctx{998244353};
+
+    uint32_t v;
+
+public:
+    static void setMod(uint32_t mod) { ctx = Barrett32(mod); }
+    static uint32_t mod() { return ctx.mod; }
+
+    DynamicModInt() : v(0) {}
+    DynamicModInt(int64_t x) {
+        int64_t r = x % (int64_t)ctx.mod;
+        v = (uint32_t)(r < 0 ? r + ctx.mod : r);
+    }
+
+    uint32_t val() const { return v; }
+
+    DynamicModInt& operator+=(DynamicModInt o) {
+        v += o.v;
+        if (v >= ctx.mod) v -= ctx.mod;
+        return *this;
+    }
+    DynamicModInt& operator-=(DynamicModInt o) {
+        v = v >= o.v ? v - o.v : v + ctx.mod - o.v;
+        return *this;
+    }
+    DynamicModInt& operator*=(DynamicModInt o) {
+        v = ctx.mul(v, o.v);
+        return *this;
+    }
+    DynamicModInt& operator/=(DynamicModInt o) { return *this *= o.inv(); }
+
+    DynamicModInt operator-() const { return DynamicModInt() - *this; }
+    friend DynamicModInt operator+(DynamicModInt a, DynamicModInt b) { return a += b; }
+    friend DynamicModInt operator-(DynamicModInt a, DynamicModInt b) { return a -= b; }
+    friend DynamicModInt operator*(DynamicModInt a, DynamicModInt b) { return a *= b; }
+    friend DynamicModInt operator/(DynamicModInt a, DynamicModInt b) { return a /= b; }
+    friend bool operator==(DynamicModInt a, DynamicModInt b) { return a.v == b.v; }
+    friend bool operator!=(DynamicModInt a, DynamicModInt b) { return a.v != b.v; }
+
+    DynamicModInt pow(uint64_t e) const {
+        DynamicModInt base = *this, r = 1;
+        while (e) {
+            if (e & 1) r *= base;
+            base *= base;
+            e >>= 1;
+        }
+        return r;
+    }
+    DynamicModInt inv() const { return DynamicModInt(inverseMod(v, ctx.mod)); }
+
+    friend std::ostream& operator<<(std::ostream& os, DynamicModInt a) { return os << a.val(); }
+};
+
+#endif
@@ -0,0 +1,327 @@
+/*
+ * 可合并线性基与并行归约
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 关键性质：线性基可以合并。
+ *   span(A ∪ B) = span(basis(A) ∪ basis(B))
+ * 所以把 B 的不超过 BITS 个基向量逐个插入 A 的基，就得到 A ∪ B 的基，
+ * 代价只有 O(BITS²)，与原数据规模无关。
+ *
+ * 并行归约：
+ * 1. 把数据切成 T 段，每个线程对自己的一段独立建基
+ * 2. 按二叉树两两合并：第1轮 0←1, 2←3, ...；第2轮 0←2, 4←6, ...
+ * 3. 任何一个线程的基满秩后即可停止读入（满秩后空间不会再变大）
+ *
+ * 查表消元（逐个插入的瓶颈是每个数最多 r 步相互依赖的消元）：
+ * 把基保持为简化阶梯形（每个主元位只出现在自己的基向量中），则
+ *   reduce(x) = x ^ T(x & 主元掩码)
+ * 其中 T 是线性映射：主元位 p 为1就异或上主元为 p 的基向量。
+ * 把 64 位按字节切成 8 段，每段预处理 256 项的表，一个数只需 8 次查表，
+ * 各次查表互不依赖；只有出现新的基向量时（至多 64 次）才重建表。
+ *
+ * 流式读取：
+ * 把二进制文件看成小端 uint64 数组，每个线程用自己的文件句柄
+ * 按块读取自己负责的字节范围，边读边插入，不需要把整个文件放进内存。
+ *
+ * 时间复杂度：逐个插入 O(n · r)；查表消元 O(8n / T + r · 2048 + T · BITS²)，r 为秩
+ * 空间复杂度：每个线程 16KB 查表 + 一个读入块
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 -pthread parallel_linear_basis.cpp -o parallel_basis
+ *   ./parallel_basis [n] [线程数]
+ */
+
+#include <bits/stdc++.h>
+#include "xor_linear_basis.h"
+using namespace std;
+
+typedef XORLinearBasis<64> Basis64;
+
+// 简化阶梯形 + 字节查表的 64 位线性基，用于批量插入
+class ReducedBasis64 {
+private:
+    uint64_t vec[64];          // vec[p]：主元为 p 的基向量，其他主元位全为0
+    uint64_t pivotMask;        // 所有主元位
+    int size;
+    uint64_t table[8][256];    // table[j][m]：第 j 个字节中主元位组合 m 对应的基向量异或
+
+    void rebuildTables() {
+        for (int j = 0; j < 8; j++) {
+            table[j][0] = 0;
+            for (int m = 1; m < 256; m++) {
+                int low = __builtin_ctz(m);
+                int bit = j * 8 + low;
+                uint64_t v = (pivotMask >> bit & 1) ? vec[bit] : 0;
+                table[j][m] = table[j][m & (m - 1)] ^ v;
+            }
+        }
+    }
+
+    // x 已约化（所有主元位为0）且非零
+    void addReduced(uint64_t x) {
+        int p = 63 - __builtin_clzll(x);
+        for (int q = 0; q < 64; q++) {
+            if ((pivotMask >> q & 1) && (vec[q] >> p & 1)) vec[q] ^= x;
+        }
+        vec[p] = x;
+        pivotMask |= 1ULL << p;
+        size++;
+        rebuildTables();
+    }
+
+public:
+    ReducedBasis64() : pivotMask(0), size(0) {
+        memset(vec, 0, sizeof(vec));
+        memset(table, 0, sizeof(table));
+    }
+
+    // 用当前基把 x 消到所有主元位为0
+    uint64_t reduce(uint64_t x) const {
+        uint64_t y = x & pivotMask;
+        return x ^ table[0][y & 255] ^ table[1][y >> 8 & 255]
+                 ^ table[2][y >> 16 & 255] ^ table[3][y >> 24 & 255]
+                 ^ table[4][y >> 32 & 255] ^ table[5][y >> 40 & 255]
+                 ^ table[6][y >> 48 & 255] ^ table[7][y >> 56];
+    }
+
+    bool insert(uint64_t x) {
+        uint64_t r = reduce(x);
+        if (!r) return false;
+        addReduced(r);
+        return true;
+    }
+
+    // 批量插入，满秩后提前结束
+    void insertMany(const uint64_t* data, size_t n) {
+        for (size_t i = 0; i < n && size < 64; i++) {
+            uint64_t r = reduce(data[i]);
+            if (__builtin_expect(r != 0, 0)) addReduced(r);
+        }
+    }
+
+    bool isFull() const { return size == 64; }
+    int getSize() const { return size; }
+
+    Basis64 toBasis() const {
+        Basis64 basis;
+        for (int p = 0; p < 64; p++) {
+            if (pivotMask >> p & 1) basis.insert(vec[p]);
+        }
+        return basis;
+    }
+};
+
+// 串行：逐个插入（基准）
+Basis64 buildBasisSerial(const uint64_t* data, size_t n) {
+    Basis64 basis;
+    for (size_t i = 0; i < n && !basis.isFull(); i++) basis.insert(data[i]);
+    return basis;
+}
+
+// 串行：查表消元
+Basis64 buildBasisReduced(const uint64_t* data, size_t n) {
+    ReducedBasis64 basis;
+    basis.insertMany(data, n);
+    return basis.toBasis();
+}
+
+// 把 partial[0..T) 按二叉树两两合并到 partial[0]
+Basis64 treeReduce(vector<Basis64>& partial) {
+    int t = partial.size();
+    for (int step = 1; step < t; step <<= 1) {
+        vector<thread> workers;
+        for (int i = 0; i + step < t; i += 2 * step) {
+            workers.emplace_back([&partial, i, step]() { partial[i].merge(partial[i + step]); });
+        }
+        for (thread& w : workers) w.join();
+    }
+    return partial.empty() ? Basis64() : partial[0];
+}
+
+// 并行：分段建基后树形合并
+Basis64 buildBasisParallel(const uint64_t* data, size_t n, int threadCount) {
+    if (threadCount <= 0) threadCount = max(1u, thread::hardware_concurrency());
+
+    vector<Basis64> partial(threadCount);
+    atomic<bool> full(false);   // 有线程满秩后通知其他线程停止
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; t++) {
+        size_t begin = n * t / threadCount, end = n * (t + 1) / threadCount;
+        workers.emplace_back([&, t, begin, end]() {
+            ReducedBasis64 basis;
+            // 每处理一块检查一次，避免频繁访问原子变量
+            const size_t BLOCK = 1 << 16;
+            for (size_t pos = begin; pos < end && !full; pos += BLOCK) {
+                basis.insertMany(data + pos, min(BLOCK, end - pos));
+                if (basis.isFull()) full = true;
+            }
+            partial[t] = basis.toBasis();
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    return treeReduce(partial);
+}
+
+// 流式：并行读取二进制文件（小端 uint64 数组），末尾不足 8 字节的部分补零
+Basis64 buildBasisFromFile(const string& path, int threadCount,
+                           size_t blockWords = 1 << 16) {
+    if (threadCount <= 0) threadCount = max(1u, thread::hardware_concurrency());
+
+    FILE* probe = fopen(path.c_str(), "rb");
+    if (!probe) {
+        cerr << "无法打开文件：" << path << endl;
+        return Basis64();
+    }
+    fseek(probe, 0, SEEK_END);
+    long long bytes = ftell(probe);
+    fclose(probe);
+    size_t words = (bytes + 7) / 8;
+
+    vector<Basis64> partial(threadCount);
+    atomic<bool> full(false);
+    atomic<bool> failed(false);   // 任一线程打开或读取失败，结果作废
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; t++) {
+        size_t begin = words * t / threadCount, end = words * (t + 1) / threadCount;
+        workers.emplace_back([&, t, begin, end]() {
+            FILE* f = fopen(path.c_str(), "rb");
+            if (!f) {
+                failed = true;
+                return;
+            }
+            fseek(f, (long long)begin * 8, SEEK_SET);
+
+            vector<uint64_t> buffer(blockWords);
+            ReducedBasis64 basis;
+            for (size_t pos = begin; pos < end && !full && !failed; pos += blockWords) {
+                size_t want = min(blockWords, end - pos);
+                fill(buffer.begin(), buffer.begin() + want, 0);
+                // 只有文件最后一块允许不足 want * 8 字节，不足的部分保持为0
+                size_t expect = min<long long>(want * 8, bytes - (long long)pos * 8);
+                size_t got = fread(buffer.data(), 1, want * 8, f);
+                if (got < expect) {
+                    failed = true;
+                    break;
+                }
+                basis.insertMany(buffer.data(), want);
+                if (basis.isFull()) full = true;
+            }
+            fclose(f);
+            partial[t] = basis.toBasis();
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    if (failed) {
+        cerr << "读取文件失败：" << path << endl;
+        return Basis64();
+    }
+    return treeReduce(partial);
+}
+
+// 生成秩为 rank 的随机数据：每个数是 rank 个固定向量的随机异或组合
+vector<uint64_t> generateLowRankData(size_t n, int rank, uint64_t seed) {
+    mt19937_64 rng(seed);
+    vector<uint64_t> generators(rank);
+    for (auto& g : generators) g = rng();
+
+    // 按 8 个生成元一组预处理所有组合，生成每个数只需查几次表
+    int groups = (rank + 7) / 8;
+    vector<array<uint64_t, 256>> table(groups);
+    for (int g = 0; g < groups; g++) {
+        for (int mask = 0; mask < 256; mask++) {
+            uint64_t v = 0;
+            for (int j = 0; j < 8 && g * 8 + j < rank; j++) {
+                if (mask >> j & 1) v ^= generators[g * 8 + j];
+            }
+            table[g][mask] = v;
+        }
+    }
+
+    vector<uint64_t> data(n);
+    for (auto& x : data) {
+        uint64_t bits = rng(), v = 0;
+        for (int g = 0; g < groups; g++) v ^= table[g][(bits >> (8 * g)) & 255];
+        x = v;
+    }
+    return data;
+}
+
+// 两个基是否张成同一空间
+bool sameSpan(const Basis64& a, const Basis64& b) {
+    if (a.getSize() != b.getSize()) return false;
+    for (uint64_t v : a.getBasis()) {
+        if (!b.canRepresent(v)) return false;
+    }
+    return true;
+}
+
+void demonstrateMerge() {
+    cout << "🌸 线性基合并演示 🌸" << endl;
+
+    Basis64 a, b;
+    for (uint64_t x : {12ULL, 9ULL, 5ULL}) a.insert(x);
+    for (uint64_t x : {3ULL, 6ULL, 16ULL}) b.insert(x);
+
+    cout << "A 的秩：" << a.getSize() << "，B 的秩：" << b.getSize() << endl;
+    int added = a.merge(b);
+    cout << "合并新增 " << added << " 个基向量，A ∪ B 的秩：" << a.getSize()
+         << "，最大异或：" << a.getMaxValue() << endl;
+    cout << endl;
+}
+
+void performanceTest(size_t n, int threadCount) {
+    cout << "🚀 性能测试：n = " << n << "，秩 = 48 🚀" << endl;
+
+    vector<uint64_t> data = generateLowRankData(n, 48, 2024);
+
+    auto t0 = chrono::high_resolution_clock::now();
+    Basis64 serial = buildBasisSerial(data.data(), n);
+    auto t1 = chrono::high_resolution_clock::now();
+    Basis64 reduced = buildBasisReduced(data.data(), n);
+    auto t2a = chrono::high_resolution_clock::now();
+    Basis64 parallel = buildBasisParallel(data.data(), n, threadCount);
+    auto t2 = chrono::high_resolution_clock::now();
+
+    double serialMs = chrono::duration<double, milli>(t1 - t0).count();
+    double reducedMs = chrono::duration<double, milli>(t2a - t1).count();
+    double parallelMs = chrono::duration<double, milli>(t2 - t2a).count();
+    double gb = n * 8.0 / (1 << 30);
+
+    cout << "串行逐个插入：" << serialMs << " ms（" << gb / (serialMs / 1000) << " GB/s）" << endl;
+    cout << "串行查表消元：" << reducedMs << " ms（" << gb / (reducedMs / 1000) << " GB/s），"
+         << "张成空间一致：" << (sameSpan(serial, reduced) ? "是" : "否") << endl;
+    cout << "并行（" << threadCount << " 线程）：" << parallelMs << " ms（"
+         << gb / (parallelMs / 1000) << " GB/s）" << endl;
+    cout << "秩：" << serial.getSize() << " / " << parallel.getSize()
+         << "，张成空间一致：" << (sameSpan(serial, parallel) ? "是" : "否") << endl;
+
+    // 写入临时文件再流式读取
+    string path = "linear_basis_stream_test.bin";
+    FILE* f = fopen(path.c_str(), "wb");
+    fwrite(data.data(), 8, n, f);
+    fclose(f);
+
+    auto t3 = chrono::high_resolution_clock::now();
+    Basis64 streamed = buildBasisFromFile(path, threadCount);
+    auto t4 = chrono::high_resolution_clock::now();
+    remove(path.c_str());
+
+    double streamMs = chrono::duration<double, milli>(t4 - t3).count();
+    cout << "流式读取文件：" << streamMs << " ms（" << gb / (streamMs / 1000) << " GB/s），"
+         << "张成空间一致：" << (sameSpan(serial, streamed) ? "是" : "否") << endl;
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? atoll(argv[1]) : 20000000;
+    int threadCount = argc > 2 ? atoi(argv[2]) : max(1u, thread::hardware_concurrency());
+
+    demonstrateMerge();
+    performanceTest(n, threadCount);
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * 前缀线性基：区间最大异或和
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 问题：给定序列 a[1..n]，在线回答 query(l, r)：
+ *       从 a[l..r] 中任选若干个数，异或和的最大值
+ *
+ * 做法（时间戳线性基）：
+ * 对每个前缀 r 保存一份线性基，并给每个基向量记录“来源位置” pos。
+ * 插入 a[r] 时，若当前位的基向量来源位置比新数更靠左，就把二者交换，
+ * 让更靠右的数留在高位，被换下来的数继续向低位消元。
+ * 这样前缀 r 的基满足：对任意 l，来源位置 >= l 的基向量
+ * 恰好张成 a[l..r] 的线性空间。
+ *
+ * 查询时只使用前缀 r 中 pos >= l 的基向量，按高位到低位贪心。
+ *
+ * 时间复杂度：预处理 O(n · BITS)，查询 O(BITS)
+ * 空间复杂度：O(n · BITS)
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 prefix_linear_basis.cpp -o prefix_basis
+ *   ./prefix_basis [n]      # 默认 n = 10^6，64 位数据
+ */
+
+#include <bits/stdc++.h>
+#include "xor_linear_basis.h"
+using namespace std;
+
+template<typename T>
+class PrefixLinearBasis {
+    static_assert(is_same<T, uint32_t>::value || is_same<T, uint64_t>::value,
+                  "PrefixLinearBasis 只支持 uint32_t / uint64_t");
+
+private:
+    static const int BITS = sizeof(T) * 8;
+
+    // 一个前缀的线性基快照
+    struct Snapshot {
+        T basis[BITS];
+        int pos[BITS];   // 基向量的来源位置（越大越靠右）
+    };
+
+    vector<Snapshot> prefix;   // prefix[r]：a[1..r] 的时间戳线性基
+
+public:
+    PrefixLinearBasis() {
+        prefix.resize(1);
+        memset(&prefix[0], 0, sizeof(Snapshot));
+    }
+
+    explicit PrefixLinearBasis(const vector<T>& a) : PrefixLinearBasis() {
+        prefix.reserve(a.size() + 1);
+        for (T x : a) push_back(x);
+    }
+
+    // 在序列末尾追加一个数，位置为 size()+1
+    void push_back(T x) {
+        prefix.push_back(prefix.back());
+        Snapshot& cur = prefix.back();
+        int p = prefix.size() - 1;
+
+        while (x) {
+            int bit = xor_basis_detail::highestBit(x);
+            if (!cur.basis[bit]) {
+                cur.basis[bit] = x;
+                cur.pos[bit] = p;
+                return;
+            }
+            // 让更靠右的数占据这一位
+            if (cur.pos[bit] < p) {
+                swap(cur.basis[bit], x);
+                swap(cur.pos[bit], p);
+            }
+            x ^= cur.basis[bit];
+        }
+    }
+
+    // a[l..r] 的最大异或和（位置从1开始）
+    T queryMax(int l, int r) const {
+        const Snapshot& snap = prefix[r];
+        T result = 0;
+        for (int i = BITS - 1; i >= 0; i--) {
+            if (snap.pos[i] >= l && !(result >> i & 1)) result ^= snap.basis[i];
+        }
+        return result;
+    }
+
+    // a[l..r] 能否异或出 x（空集视为能表示0）
+    bool canRepresent(int l, int r, T x) const {
+        const Snapshot& snap = prefix[r];
+        for (int i = BITS - 1; i >= 0 && x; i--) {
+            if (!(x >> i & 1)) continue;
+            if (snap.pos[i] < l) return false;
+            x ^= snap.basis[i];
+        }
+        return x == 0;
+    }
+
+    int size() const { return prefix.size() - 1; }
+};
+
+// 暴力：对 a[l..r] 现建一个线性基
+uint64_t bruteForceMax(const vector<uint64_t>& a, int l, int r) {
+    XORLinearBasis<64> basis;
+    for (int i = l; i <= r; i++) basis.insert(a[i - 1]);
+    return basis.getMaxValue();
+}
+
+void demonstratePrefixBasis() {
+    cout << "🌸 前缀线性基演示 🌸" << endl;
+    cout << endl;
+
+    vector<uint64_t> a = {12, 9, 5, 3, 7, 10, 6};
+    PrefixLinearBasis<uint64_t> pb(a);
+
+    cout << "序列：";
+    for (uint64_t x : a) cout << x << " ";
+    cout << endl;
+
+    int queries[][2] = {{1, 7}, {2, 4}, {3, 3}, {4, 6}, {5, 7}};
+    for (auto& q : queries) {
+        cout << "区间 [" << q[0] << ", " << q[1] << "] 最大异或和："
+             << pb.queryMax(q[0], q[1])
+             << "（暴力：" << bruteForceMax(a, q[0], q[1]) << "）" << endl;
+    }
+    cout << endl;
+}
+
+void verifyAgainstBruteForce() {
+    cout << "🔍 随机对拍 🔍" << endl;
+
+    mt19937_64 rng(42);
+    bool ok = true;
+    for (int round = 0; round < 100 && ok; round++) {
+        int n = rng() % 60 + 1;
+        vector<uint64_t> a(n);
+        // 只用少数几位，制造大量线性相关
+        for (auto& x : a) x = rng() & 0x8000F0000000000FULL;
+
+        PrefixLinearBasis<uint64_t> pb(a);
+        for (int l = 1; l <= n && ok; l++) {
+            for (int r = l; r <= n && ok; r++) {
+                ok = pb.queryMax(l, r) == bruteForceMax(a, l, r);
+            }
+        }
+    }
+    cout << (ok ? "✓ 所有区间结果与暴力一致" : "✗ 发现不一致") << endl;
+    cout << endl;
+}
+
+void performanceTest(int n) {
+    cout << "🚀 性能测试：n = " << n << "，64 位数据 🚀" << endl;
+
+    mt19937_64 rng(2024);
+    vector<uint64_t> a(n);
+    for (auto& x : a) x = rng();
+
+    const int q = 1000000;
+    vector<pair<int, int>> queries(q);
+    for (auto& query : queries) {
+        int l = rng() % n + 1;
+        int r = l + rng() % (n - l + 1);
+        query = {l, r};
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+    PrefixLinearBasis<uint64_t> pb(a);
+    auto mid = chrono::high_resolution_clock::now();
+    uint64_t checksum = 0;
+    for (auto& query : queries) checksum ^= pb.queryMax(query.first, query.second);
+    auto end = chrono::high_resolution_clock::now();
+
+    cout << "预处理：" << chrono::duration_cast<chrono::milliseconds>(mid - start).count()
+         << " ms，内存约 " << (size_t)(n + 1) * (64 * 12) / (1 << 20) << " MB" << endl;
+    cout << q << " 次查询：" << chrono::duration_cast<chrono::milliseconds>(end - mid).count()
+         << " ms（校验值 " << checksum << "）" << endl;
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    demonstratePrefixBasis();
+    verifyAgainstBruteForce();
+    performanceTest(n);
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * 逆元 / 阶乘 / 调和数前缀表：正确性验证与启动时间对比
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 实现见 prefix_tables.h，题目见 算法报告_扭蛋机最少期望次数.md。
+ *
+ * 1. 与报告中的线性递推 inv[i] = (P - P/i) · inv[P mod i] 逐项比较；扭蛋机两个样例；
+ *    保存 → 映射往返；模数不符、长度不够、文件被截断或被改写时拒绝映射
+ * 2. 性能（A 默认 10^7，模数 19260817）：
+ *    - 报告写法：线性递推求逆元 + 前缀和
+ *    - build：三遍顺序扫描
+ *    - save 落盘；open 映射（“后续进程”的启动开销）以及映射后第一次完整扫描
+ *    - 映射后回答 10^6 个扭蛋机层求和询问
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 prefix_tables.cpp -o prefix_tables
+ *   ./prefix_tables [A] [表文件路径]
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "prefix_tables.h"
+
+using namespace std;
+
+const uint32_t P = 19260817;
+
+// 报告第 4 节的写法
+void reportTables(uint32_t mod, uint64_t n, vector<uint32_t>& inv, vector<uint32_t>& harmonic) {
+    inv.assign(n + 1, 0);
+    harmonic.assign(n + 1, 0);
+    inv[1] = 1;
+    for (uint64_t i = 2; i <= n; i++) inv[i] = (uint64_t)(mod - mod / i) * inv[mod % i] % mod;
+    for (uint64_t i = 1; i <= n; i++) harmonic[i] = (harmonic[i - 1] + inv[i]) % mod;
+}
+
+// E = Σ s_j · (H_{A-s_{j-1}} - H_{A-s_j})，s 为 a 升序去重，A = s_t
+uint32_t gachaExpectation(const PrefixTables& t, vector<uint32_t> a) {
+    sort(a.begin(), a.end());
+    a.erase(unique(a.begin(), a.end()), a.end());
+    uint64_t A = a.back(), ans = 0, prev = 0;
+    for (uint32_t s : a) {
+        ans = (ans + (uint64_t)s % t.mod() * t.harmonicRange(A - s + 1, A - prev)) % t.mod();
+        prev = s;
+    }
+    return (uint32_t)ans;
+}
+
+bool sameTables(const PrefixTables& a, const PrefixTables& b) {
+    if (a.mod() != b.mod() || a.size() != b.size()) return false;
+    for (uint64_t k = 0; k <= a.size(); k++) {
+        if (a.inv(k) != b.inv(k) || a.fact(k) != b.fact(k) || a.invFact(k) != b.invFact(k)
+            || a.harmonic(k) != b.harmonic(k)) return false;
+    }
+    return true;
+}
+
+void testCorrectness(const string& path) {
+    cout << "=== 正确性验证 ===" << endl;
+    int errors = 0;
+    auto report = [&errors](const char* name) {
+        cout << name << "：" << (errors == 0 ? "✓" : "✗") << endl;
+        errors = 0;
+    };
+
+    vector<pair<uint32_t, uint64_t>> cases = {{P, 200000}, {1000000007u, 200000}, {998244353u, 200000}, {7u, 6}, {2u, 1}};
+    for (uint64_t n = 1; n <= 20; n++) cases.push_back({P, n});   // 分段边界
+    for (auto [mod, n] : cases) {
+        PrefixTables t = PrefixTables::build(mod, n);
+        vector<uint32_t> inv, harmonic;
+        reportTables(mod, n, inv, harmonic);
+        uint64_t f = 1;
+        for (uint64_t k = 1; k <= n; k++) {
+            f = f * k % mod;
+            if (t.inv(k) != inv[k] || t.harmonic(k) != harmonic[k] || t.fact(k) != f
+                || (uint64_t)t.fact(k) * t.invFact(k) % mod != 1) {
+                cout << "错误: mod = " << mod << ", k = " << k << endl;
+                errors++;
+                break;
+            }
+        }
+        if (n >= 10 && t.binomial(10, 3) != 120 % mod) errors++;
+    }
+    report("逆元 / 调和数 / 阶乘表与逐项递推（含 n = 1..20 的分段边界）");
+
+    PrefixTables t = PrefixTables::build(P, 100);
+    if (gachaExpectation(t, {1, 2, 3}) != 12840549 || gachaExpectation(t, {1, 5, 3}) != 2889132) {
+        cout << "错误: 扭蛋机样例" << endl;
+        errors++;
+    }
+    if (PrefixTables::build(P, P).valid() || PrefixTables::build(P, 0).valid()) errors++;
+    report("扭蛋机样例、拒绝 n = 0 与 n ≥ 模数");
+
+    // 往返与拒绝
+    PrefixTables built = PrefixTables::build(P, 100000);
+    if (!built.save(path)) {
+        cout << "错误: 无法写入 " << path << endl;
+        errors++;
+    }
+    {
+        PrefixTables mapped = PrefixTables::open(path, P, 100000);
+        if (!mapped.isMapped() || !sameTables(built, mapped)) errors++;
+        if (!PrefixTables::open(path, P, 5000).valid()) errors++;        // 表更长也可用
+        if (PrefixTables::open(path, 998244353).valid()) errors++;       // 模数不符
+        if (PrefixTables::open(path, P, 100001).valid()) errors++;       // 长度不够
+        if (PrefixTables::open(path + ".missing").valid()) errors++;
+        PrefixTables moved = std::move(mapped);
+        if (mapped.valid() || !sameTables(built, moved)) errors++;
+    }
+    report("保存后映射、模数与长度校验、移动");
+    {
+        // 改写中间一项：抽查覆盖 n/2
+        FILE* f = fopen(path.c_str(), "r+b");
+        uint32_t junk = 12345;
+        fseek(f, 32 + 4 * 50000, SEEK_SET);
+        fwrite(&junk, 4, 1, f);
+        fclose(f);
+        if (PrefixTables::open(path).valid()) errors++;
+        // 截断
+        if (truncate(path.c_str(), 1000) != 0 || PrefixTables::open(path).valid()) errors++;
+    }
+    report("改写中间一项、截断后拒绝映射");
+    // loadOrBuild 在文件损坏时重建并覆盖
+    {
+        PrefixTables a = PrefixTables::loadOrBuild(path, P, 100000);
+        PrefixTables b = PrefixTables::loadOrBuild(path, P, 100000);
+        if (a.isMapped() || !b.isMapped() || !sameTables(a, b)) errors++;
+    }
+    remove(path.c_str());
+    report("loadOrBuild 在文件损坏时重建");
+    cout << endl;
+}
+
+template<typename Func>
+double measureMs(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+}
+
+void performanceTest(uint64_t n, const string& path) {
+    cout << "=== 性能测试：A = " << n << "，模数 " << P << " ===" << endl;
+
+    vector<uint32_t> inv, harmonic;
+    double tReport = measureMs([&] { reportTables(P, n, inv, harmonic); });
+    printf("  报告写法（逆元递推 + 前缀和）   %9.2f ms\n", tReport);
+
+    PrefixTables built;
+    double tBuild = measureMs([&] { built = PrefixTables::build(P, n); });
+    printf("  build（逆元 + 阶乘 + 调和数）   %9.2f ms  %s\n", tBuild,
+           built.harmonic(n) == harmonic[n] ? "" : "[结果不一致]");
+    inv.clear(), inv.shrink_to_fit(), harmonic.clear(), harmonic.shrink_to_fit();
+
+    double tSave = measureMs([&] { built.save(path); });
+    printf("  save（%.0f MB）                 %9.2f ms\n", 16.0 * (n + 1) / 1e6, tSave);
+
+    PrefixTables mapped;
+    double tOpen = measureMs([&] { mapped = PrefixTables::open(path, P, n); });
+    printf("  open（mmap + 头部校验）          %9.3f ms  %s\n", tOpen, mapped.isMapped() ? "" : "[映射失败]");
+
+    uint64_t checksum = 0;
+    double tScan = measureMs([&] {
+        for (uint64_t k = 0; k <= n; k++) checksum += mapped.harmonic(k);
+    });
+    printf("  映射后首次顺序扫描 H[0..A]       %9.2f ms\n", tScan);
+
+    // 10^6 个询问，每个询问 8 台扭蛋机
+    mt19937_64 rng(1);
+    const int QUERIES = 1000000;
+    vector<uint32_t> a(8);
+    double tQuery = measureMs([&] {
+        for (int q = 0; q < QUERIES; q++) {
+            for (auto& x : a) x = rng() % n + 1;
+            checksum += gachaExpectation(mapped, a);
+        }
+    });
+    printf("  10^6 个扭蛋机询问（各 8 台）     %9.2f ms\n", tQuery);
+    printf("  后续进程启动：open %.3f ms，对比重新建表 %.2f ms（校验 %llu）\n",
+           tOpen, tBuild, (unsigned long long)checksum);
+    remove(path.c_str());
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t n = argc > 1 ? atoll(argv[1]) : 10000000;
+    string path = argc > 2 ? argv[2] : "/tmp/prefix_tables_19260817.bin";
+
+    testCorrectness(path);
+    performanceTest(n, path);
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*
+ * 逆元 / 阶乘 / 调和数前缀表：一次预处理，落盘后用 mmap 直接复用
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 算法报告_扭蛋机最少期望次数.md 的答案是 E = Σ s_j · (H_{A-s_{j-1}} - H_{A-s_j}) (mod 19260817)，
+ * 需要 H_0..H_A（A ≤ 10^7）；同一模数下反复求这类前缀和时，每个进程都重新做
+ * O(A) 的预处理并不划算。本文件：
+ *
+ * - PrefixTables::build(mod, n)     在内存中建表，要求 mod 为素数、n < mod
+ * - save(path)                      写成二进制文件（先写临时文件再 rename，不会留下半个文件）
+ * - PrefixTables::open(path, ...)   mmap 只读映射，按需缺页，打开本身是 O(1)；
+ *                                   头部不匹配（魔数、版本、模数、长度）时返回无效对象
+ * - PrefixTables::loadOrBuild(...)  有可用文件就映射，否则建表并保存
+ *
+ * 建表：
+ *   fact[i] = fact[i-1] · i
+ *   invFact[n] = fact[n]^(p-2)，invFact[i-1] = invFact[i] · i
+ *   inv[i] = invFact[i] · fact[i-1]，H[i] = H[i-1] + inv[i]
+ * 一次快速幂加约 3n 次 Barrett 乘法，全是顺序访存，也不需要报告里
+ * inv[i] = (P - P/i) · inv[P mod i] 那样每项一次除法。前两条是乘法依赖链，
+ * 把 1..n 切成 LANES 段交错推进，各段先求段内部分积，最后一遍再乘上段外的常数。
+ * n = 10^7 时四张表共 160MB，建表时间里一半以上是首次写入的缺页，
+ * 映射已有文件则完全不需要这部分开销。
+ *
+ * 文件格式（小端，与本机内存布局一致，不做字节序转换）：
+ *   Header（32 字节）后依次是 inv、fact、invFact、harmonic 四个 uint32 数组，各 n + 1 项
+ */
+
+#ifndef PREFIX_TABLES_H
+#define PREFIX_TABLES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mod_int.h"
+
+class PrefixTables {
+    static constexpr uint64_t MAGIC = 0x4C4254504B415559ULL;   // "YUKAPTBL"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int TABLES = 4;
+    static constexpr int LANES = 4;   // 建表时交错推进的乘法链条数
+
+    struct Header {
+        uint64_t magic;
+        uint32_t version, mod;
+        uint64_t n;
+        uint64_t reserved;
+    };
+    static_assert(sizeof(Header) == 32, "Header 须为 32 字节");
+
+    uint32_t mod_ = 0;
+    uint64_t n_ = 0;
+    Barrett32 br{2};
+    const uint32_t* data = nullptr;   // 四张表首尾相接，各 n + 1 项
+
+    std::unique_ptr<uint32_t[]> owned;   // build 得到的表（不清零，避免多写一遍 160MB）
+    void* mapped = nullptr;           // open 得到的映射
+    size_t mappedBytes = 0;
+
+    const uint32_t* table(int t) const { return data + (size_t)t * (n_ + 1); }
+
+    void release() {
+        if (mapped) munmap(mapped, mappedBytes);
+        mapped = nullptr, mappedBytes = 0;
+        owned.reset();
+        data = nullptr, mod_ = 0, n_ = 0;
+    }
+
+    void setMod(uint32_t mod, uint64_t n) {
+        mod_ = mod, n_ = n;
+        br = Barrett32(mod);
+    }
+
+    void moveFrom(PrefixTables& o) {
+        mod_ = o.mod_, n_ = o.n_, br = o.br;
+        owned = std::move(o.owned);
+        mapped = o.mapped, mappedBytes = o.mappedBytes, data = o.data;
+        o.mapped = nullptr, o.mappedBytes = 0, o.data = nullptr, o.mod_ = 0, o.n_ = 0;
+    }
+
+    // 抽查几处恒等式，挡住被截断或被其他程序覆盖的文件（不逐项校验，否则打开就不是 O(1) 了）
+    bool spotCheck() const {
+        const uint64_t probes[] = {1, 2, n_ / 3, n_ / 2, n_ - 1, n_};
+        for (uint64_t k : probes) {
+            if (k == 0 || k > n_) continue;
+            if (br.mul(inv(k), (uint32_t)k) != 1 || br.mul(fact(k), invFact(k)) != 1) return false;
+            if (br.mul(fact(k - 1), (uint32_t)k) != fact(k)) return false;
+            if (harmonic(k) != (harmonic(k - 1) + inv(k)) % mod_) return false;
+        }
+        return fact(0) == 1 && harmonic(0) == 0;
+    }
+
+public:
+    PrefixTables() {}
+    ~PrefixTables() { release(); }
+    PrefixTables(const PrefixTables&) = delete;
+    PrefixTables& operator=(const PrefixTables&) = delete;
+    PrefixTables(PrefixTables&& o) noexcept { moveFrom(o); }
+    PrefixTables& operator=(PrefixTables&& o) noexcept {
+        if (this != &o) release(), moveFrom(o);
+        return *this;
+    }
+
+    // 素数 mod，1 ≤ n < mod（n ≥ mod 时 n! ≡ 0，逆元不存在）
+    static PrefixTables build(uint32_t mod, uint64_t n) {
+        PrefixTables t;
+        if (mod < 2 || n == 0 || n >= mod) return t;
+        t.setMod(mod, n);
+        t.owned.reset(new uint32_t[(size_t)TABLES * (n + 1)]);
+        t.data = t.owned.get();
+        uint32_t* inv = t.owned.get();
+        uint32_t* fact = inv + (n + 1);
+        uint32_t* invFact = fact + (n + 1);
+        uint32_t* harmonic = invFact + (n + 1);
+        const Barrett32& br = t.br;
+
+        // 第 k 段为 [lo[k], hi[k]]，可能为空（lo > hi）
+        uint64_t len = (n + LANES - 1) / LANES, lo[LANES], hi[LANES];
+        for (int k = 0; k < LANES; k++) lo[k] = k * len + 1, hi[k] = std::min(n, (k + 1) * len);
+
+        // fact[i] 先存段内前缀积 lo..i；before[k] = (lo[k] - 1)!
+        uint32_t acc[LANES], before[LANES], after[LANES];
+        std::fill(acc, acc + LANES, 1u);
+        for (uint64_t s = 0; s < len; s++) {
+            for (int k = 0; k < LANES; k++) {
+                uint64_t i = lo[k] + s;
+                if (i <= hi[k]) fact[i] = acc[k] = br.mul(acc[k], (uint32_t)i);
+            }
+        }
+        before[0] = 1;
+        for (int k = 1; k < LANES; k++) before[k] = br.mul(before[k - 1], acc[k - 1]);
+
+        uint32_t x = br.mul(before[LANES - 1], acc[LANES - 1]), r = 1;   // x = n!
+        for (uint32_t e = mod - 2; e; e >>= 1, x = br.mul(x, x)) {
+            if (e & 1) r = br.mul(r, x);
+        }
+
+        // invFact[i] 先存段内后缀积 (i+1)..hi；after[k] = (hi[k])!^-1
+        std::fill(acc, acc + LANES, 1u);
+        for (uint64_t s = 0; s < len; s++) {
+            for (int k = 0; k < LANES; k++) {
+                if (lo[k] + s > hi[k]) continue;
+                uint64_t i = hi[k] - s;
+                invFact[i] = acc[k];
+                acc[k] = br.mul(acc[k], (uint32_t)i);
+            }
+        }
+        after[LANES - 1] = r;
+        for (int k = LANES - 2; k >= 0; k--) after[k] = br.mul(after[k + 1], acc[k + 1]);
+
+        // 乘上段外常数，顺带求逆元与调和数
+        fact[0] = invFact[0] = 1, inv[0] = harmonic[0] = 0;
+        uint32_t prevFact = 1, h = 0;
+        for (int k = 0; k < LANES; k++) {
+            for (uint64_t i = lo[k]; i <= hi[k]; i++) {
+                uint32_t f = br.mul(fact[i], before[k]), g = br.mul(invFact[i], after[k]);
+                uint32_t v = br.mul(g, prevFact);
+                fact[i] = f, invFact[i] = g, inv[i] = v, prevFact = f;
+                h += v;
+                if (h >= mod) h -= mod;
+                harmonic[i] = h;
+            }
+        }
+        return t;
+    }
+
+    bool save(const std::string& path) const {
+        if (!valid()) return false;
+        std::string tmp = path + ".tmp";
+        FILE* f = fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+        Header h{MAGIC, VERSION, mod_, n_, 0};
+        size_t count = (size_t)TABLES * (n_ + 1);
+        bool ok = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(data, sizeof(uint32_t), count, f) == count;
+        ok = (fclose(f) == 0) && ok;
+        if (ok) ok = rename(tmp.c_str(), path.c_str()) == 0;
+        if (!ok) remove(tmp.c_str());
+        return ok;
+    }
+
+    // mod / n 为 0 表示不限定；表比需要的长也可以用（n 只是下限）
+    static PrefixTables open(const std::string& path, uint32_t mod = 0, uint64_t n = 0, bool populate = false) {
+        PrefixTables t;
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return t;
+        struct stat st;
+        Header h;
+        bool ok = fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(Header)
+                  && pread(fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h)
+                  && h.magic == MAGIC && h.version == VERSION && h.mod >= 2 && h.n >= 1 && h.n < h.mod
+                  && (mod == 0 || h.mod == mod) && h.n >= n
+                  && (uint64_t)st.st_size == sizeof(Header) + (uint64_t)TABLES * (h.n + 1) * sizeof(uint32_t);
+        if (ok) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED | (populate ? MAP_POPULATE : 0), fd, 0);
+            if (p != MAP_FAILED) {
+                t.mapped = p, t.mappedBytes = st.st_size;
+                t.setMod(h.mod, h.n);
+                t.data = (const uint32_t*)((const char*)p + sizeof(Header));
+                if (!t.spotCheck()) t.release();
+            }
+        }
+        ::close(fd);   // 映射在 close 之后依然有效
+        return t;
+    }
+
+    static PrefixTables loadOrBuild(const std::string& path, uint32_t mod, uint64_t n) {
+        PrefixTables t = open(path, mod, n);
+        if (t.valid()) return t;
+        t = build(mod, n);
+        t.save(path);   // 保存失败（如目录不可写）不影响本次使用
+        return t;
+    }
+
+    bool valid() const { return data != nullptr; }
+    bool isMapped() const { return mapped != nullptr; }
+    uint32_t mod() const { return mod_; }
+    uint64_t size() const { return n_; }   // 可查询的下标为 0..size()
+
+    uint32_t inv(uint64_t k) const { return table(0)[k]; }        // k^-1，inv(0) = 0
+    uint32_t fact(uint64_t k) const { return table(1)[k]; }
+    uint32_t invFact(uint64_t k) const { return table(2)[k]; }
+    uint32_t harmonic(uint64_t k) const { return table(3)[k]; }   // H_k = Σ_{i ≤ k} i^-1
+
+    // 整张表的首地址（各 size() + 1 项），供向量化内核直接读取
+    const uint32_t* invData() const { return table(0); }
+    const uint32_t* factData() const { return table(1); }
+    const uint32_t* invFactData() const { return table(2); }
+    const uint32_t* harmonicData() const { return table(3); }
+
+    // H_r - H_{l-1} = Σ_{i=l..r} i^-1（l = 0 与 l = 1 相同）
+    uint32_t harmonicRange(uint64_t l, uint64_t r) const {
+        if (l == 0) l = 1;
+        if (l > r) return 0;
+        uint32_t a = harmonic(r), b = harmonic(l - 1);
+        return a >= b ? a - b : a + mod_ - b;
+    }
+
+    // C(a, b)，a ≤ size()
+    uint32_t binomial(uint64_t a, uint64_t b) const {
+        if (b > a) return 0;
+        return br.mul(br.mul(fact(a), invFact(b)), invFact(a - b));
+    }
+};
+
+#endif
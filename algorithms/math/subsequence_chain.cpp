@@ -0,0 +1,180 @@
+/*
+ * 子序列标题链计数：正确性验证与性能测试
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 实现见 subsequence_chain.h，推导见 算法报告_子序列标题计数.md。
+ *
+ * 1. 小规模枚举：长度 A 的全部串中包含固定 t（长度 B）作为子序列的个数 = W(A, B)；
+ *    随机链与报告第 10 节的伪代码逐一比较；样例、m ≡ 0 / 1、B = 0 等边界
+ * 2. 性能（a_1 默认 10^7，MOD = 1e9+7）：
+ *    - 阶乘表：首次建表并落盘，之后的进程直接映射
+ *    - 几种链形状下，报告写法与 SubsequenceChainCounter 的单次询问耗时
+ *    - 同一条链上 20 个不同 m 的询问（共享阶乘表与缓冲区）
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 subsequence_chain.cpp -o subsequence_chain
+ *   ./subsequence_chain [a_1] [阶乘表文件路径]
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "subsequence_chain.h"
+
+using namespace std;
+
+const uint32_t MOD = 1000000007;
+
+long long powerMod(long long a, unsigned long long e) {
+    long long r = 1;
+    a %= MOD;
+    for (; e; e >>= 1, a = a * a % MOD) {
+        if (e & 1) r = r * a % MOD;
+    }
+    return r;
+}
+
+// 报告第 10 节的伪代码
+uint32_t reportCount(uint64_t m, const vector<uint64_t>& a) {
+    uint64_t D = a.front() - a.back();
+    vector<long long> inv(D + 2, 1);
+    for (uint64_t i = 2; i <= D + 1; i++) inv[i] = (MOD - (MOD / i) * inv[MOD % i] % MOD) % MOD;
+    long long x = (long long)((m % MOD + MOD - 1) % MOD);
+    long long ans = powerMod(m, a.back());
+    for (size_t i = 1; i < a.size(); i++) {
+        long long A = a[i - 1], delta = A - a[i], comb = 1, pw = 1, sum = 0;
+        for (long long t = 0; t <= delta; t++) {
+            sum = (sum + comb * pw) % MOD;
+            comb = comb * ((A - t) % MOD) % MOD * inv[t + 1] % MOD;
+            pw = pw * x % MOD;
+        }
+        ans = ans * sum % MOD;
+    }
+    return (uint32_t)ans;
+}
+
+// 枚举长度 A 的串，统计包含 t = 0^B 作为子序列的个数（W 与 t 的内容无关）
+uint64_t bruteW(int m, int A, int B) {
+    uint64_t total = 1, cnt = 0;
+    for (int i = 0; i < A; i++) total *= m;
+    for (uint64_t code = 0; code < total; code++) {
+        int zeros = 0;
+        for (uint64_t c = code; zeros < B && c; c /= m) zeros += c % m == 0;
+        // 高位补 0
+        uint64_t c = code;
+        int digits = 0;
+        while (c) c /= m, digits++;
+        zeros += A - digits;
+        cnt += zeros >= B;
+    }
+    return cnt;
+}
+
+void testCorrectness(const PrefixTables& tables) {
+    cout << "=== 正确性验证 ===" << endl;
+    SubsequenceChainCounter counter(tables);
+    mt19937_64 rng(2024);
+
+    cout << "W(A, B) 与暴力枚举（A ≤ 9）：";
+    for (int m = 1; m <= 3; m++) {
+        bool ok = true;
+        for (int A = 1; A <= 9; A++) {
+            for (int B = 0; B < A; B++) {
+                vector<uint32_t> w;
+                counter.weights(m, {(uint64_t)A, (uint64_t)B}, w);
+                ok = ok && w[0] == bruteW(m, A, B) % MOD;
+            }
+        }
+        cout << "m=" << m << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl;
+
+    cout << "样例 m = 2, a = {3, 1} 答案 14：" << (counter.count(2, {3, 1}) == 14 ? "✓" : "✗") << endl;
+
+    cout << "与报告写法对拍（a_1 ≤ 5000）：";
+    for (uint64_t m : vector<uint64_t>{1, (uint64_t)MOD + 1, MOD, 2ULL * MOD, 123456789012345ULL, 26}) {
+        bool ok = true;
+        for (int rep = 0; rep < 30; rep++) {
+            int n = rng() % 6 + 1;
+            vector<uint64_t> a(n);
+            a[0] = rng() % min<uint64_t>(5000, tables.size()) + 1;
+            for (int i = 1; i < n; i++) a[i] = rng() % a[0];
+            sort(a.rbegin(), a.rend());
+            a.erase(unique(a.begin(), a.end()), a.end());
+            ok = ok && counter.count(m, a) == reportCount(m, a);
+        }
+        cout << "m=" << m << (ok ? " ✓ " : " ✗ ");
+    }
+    cout << endl;
+
+    // 不合法输入
+    bool rejected = counter.count(2, {3, 3}) == 0 && counter.count(2, {tables.size() + 1, 1}) == 0;
+    cout << "拒绝非严格递减的 a 与超出表长的 a_1：" << (rejected ? "✓" : "✗") << endl << endl;
+}
+
+template<typename Func>
+double measureMs(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+}
+
+void performanceTest(const PrefixTables& tables, uint64_t a1) {
+    cout << "=== 性能测试：a_1 = " << a1 << " ===" << endl;
+    SubsequenceChainCounter counter(tables);
+    mt19937_64 rng(7);
+
+    auto randomChain = [&](int n) {
+        vector<uint64_t> a = {a1};
+        while ((int)a.size() < n) a.push_back(rng() % a1);
+        sort(a.rbegin(), a.rend());
+        a.erase(unique(a.begin(), a.end()), a.end());
+        return a;
+    };
+    struct Shape { const char* name; vector<uint64_t> a; };
+    vector<Shape> shapes = {
+        {"[a_1, a_1/2]", {a1, a1 / 2}},
+        {"[a_1, a_1/10]", {a1, a1 / 10}},
+        {"[a_1, 1]", {a1, 1}},
+        {"随机 1000 层", randomChain(1000)},
+        {"随机 10^5 层", randomChain(100000)},
+    };
+    for (auto& s : shapes) {
+        uint32_t r1 = 0, r2 = 0;
+        double tReport = measureMs([&] { r1 = reportCount(26, s.a); });
+        double tCounter = measureMs([&] { r2 = counter.count(26, s.a); });
+        printf("  %-14s 报告写法 %9.2f ms, SubsequenceChainCounter %8.2f ms, 加速 %6.1fx  %s\n",
+               s.name, tReport, tCounter, tReport / tCounter, r1 == r2 ? "" : "[结果不一致]");
+    }
+
+    // 同一条链、20 个不同的 m
+    vector<uint64_t> a = randomChain(1000);
+    uint64_t checksum = 0;
+    double t = measureMs([&] {
+        for (int q = 0; q < 20; q++) checksum += counter.count(rng() % 1000000 + 2, a);
+    });
+    printf("  随机 1000 层 × 20 个 m：共 %.2f ms，平均 %.2f ms/询问（校验 %llu）\n",
+           t, t / 20, (unsigned long long)checksum);
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t a1 = argc > 1 ? atoll(argv[1]) : 10000000;
+    string path = argc > 2 ? argv[2] : "/tmp/prefix_tables_1000000007.bin";
+
+    PrefixTables tables;
+    bool existed = PrefixTables::open(path, MOD, a1).valid();
+    double tLoad = measureMs([&] { tables = PrefixTables::loadOrBuild(path, MOD, a1); });
+    printf("阶乘表（n = %llu）：%s %.2f ms\n\n", (unsigned long long)tables.size(),
+           existed ? "映射已有文件" : "建表并落盘", tLoad);
+
+    testCorrectness(tables);
+    performanceTest(tables, a1);
+
+    return 0;
+}
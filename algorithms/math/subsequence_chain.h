@@ -0,0 +1,225 @@
+/*
+ * 子序列标题链计数：批量求 W(A, B)
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 推导见 算法报告_子序列标题计数.md：
+ *   W(A, B) = Σ_{t=0}^{A-B} C(A, t) · x^t，x = m - 1
+ *   Ans = m^{a_n} · Π_{i=2..n} W(a_{i-1}, a_i)
+ * 报告的写法每一项做 C(A, t+1) = C(A, t) · (A - t) · inv[t+1] 与 x^{t+1} = x^t · x，
+ * 四次取模且两条乘法依赖链，总共 Σ (a_{i-1} - a_i) 项。本文件：
+ *
+ * - 阶乘表由 PrefixTables（prefix_tables.h）提供，可以从文件映射，多个询问、多个进程共享。
+ *   C(A, t) = A! · invFact[t] · invFact[A-t]，于是
+ *     W(A, B) = A! · Σ_{t=0}^{Δ} head[t] · invFact[A-t]，head[t] = invFact[t] · x^t，Δ = A - B
+ * - head 只与 x 有关：每个询问按 t 递增建一次（x 的幂分四条链交错递推），链上所有 W 共用。
+ *   head 倒序存放后，每个 W 就是两段连续数组的点积，乘积在 64 位里延迟约简
+ *   （matrix_power.h 的折叠 acc = hi·(2^32 mod m) + lo），可以整段向量化
+ * - Δ 很大而 B 很小时改用补集：Σ_t C(A, t) x^t = m^A，
+ *     W(A, B) = m^A - A! · x^A · Σ_{j=0}^{B-1} tail[j] · invFact[A-j]，tail[j] = invFact[j] · x^{-j}
+ *   每个 W 的代价为 min(Δ + 1, B) 项
+ *
+ * 单个询问：O(n log A + Σ min(a_{i-1} - a_i + 1, a_i))；要求 a_1 ≤ tables.size()。
+ */
+
+#ifndef SUBSEQUENCE_CHAIN_H
+#define SUBSEQUENCE_CHAIN_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "mod_int.h"
+#include "matrix_power.h"
+#include "prefix_tables.h"
+
+namespace subsequence_chain_detail {
+
+// Σ a[i] · b[i] mod m。每累加 block 个乘积（每条 64 位通道）折叠一次
+struct DotContext {
+    Barrett32 br;
+    uint32_t r;       // 2^32 mod m
+    size_t block;
+
+    explicit DotContext(uint32_t mod)
+        : br(mod), r((uint32_t)((1ULL << 32) % mod)),
+          block((size_t)std::min<uint64_t>(matrix_power_detail::foldedTerms(mod), 1u << 20)) {}
+
+    uint64_t fold(uint64_t acc) const { return (acc >> 32) * r + (uint32_t)acc; }
+    // 折叠后 < 2^32 · m，Barrett 可以直接约简
+    uint32_t finish(const uint64_t* acc, int lanes) const {
+        uint64_t s = 0;
+        for (int k = 0; k < lanes; k++) s += br.reduce(fold(acc[k]));
+        return br.reduce(s);
+    }
+};
+
+inline uint32_t dotScalar(const uint32_t* a, const uint32_t* b, size_t len, const DotContext& ctx) {
+    uint64_t acc[4] = {};
+    size_t i = 0, sinceFold = 0;
+    for (; i + 4 <= len; i += 4) {
+        for (int k = 0; k < 4; k++) acc[k] += (uint64_t)a[i + k] * b[i + k];
+        if (++sinceFold == ctx.block) {
+            for (int k = 0; k < 4; k++) acc[k] = ctx.fold(acc[k]);
+            sinceFold = 0;
+        }
+    }
+    for (int k = 0; i < len; i++, k++) acc[k] = ctx.fold(acc[k]) + (uint64_t)a[i] * b[i];
+    return ctx.finish(acc, 4);
+}
+
+#ifdef MATRIX_POWER_X86
+using matrix_power_detail::foldLanesAvx2;
+using matrix_power_detail::foldLanesAvx512;
+
+__attribute__((target("avx2")))
+inline uint32_t dotAvx2(const uint32_t* a, const uint32_t* b, size_t len, const DotContext& ctx) {
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    __m256i vr = _mm256_set1_epi64x(ctx.r), low = _mm256_set1_epi64x(0xFFFFFFFFu);
+    size_t i = 0, sinceFold = 0;
+    for (; i + 8 <= len; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        // mul_epu32 取每个 64 位通道的低 32 位：偶数下标直接乘，奇数下标右移 32 位后乘
+        acc0 = _mm256_add_epi64(acc0, _mm256_mul_epu32(va, vb));
+        acc1 = _mm256_add_epi64(acc1, _mm256_mul_epu32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)));
+        if (++sinceFold == ctx.block) {
+            acc0 = foldLanesAvx2(acc0, vr, low), acc1 = foldLanesAvx2(acc1, vr, low);
+            sinceFold = 0;
+        }
+    }
+    alignas(32) uint64_t lanes[9];
+    _mm256_store_si256((__m256i*)lanes, foldLanesAvx2(acc0, vr, low));
+    _mm256_store_si256((__m256i*)(lanes + 4), foldLanesAvx2(acc1, vr, low));
+    lanes[8] = dotScalar(a + i, b + i, len - i, ctx);
+    return ctx.finish(lanes, 9);
+}
+
+// maskz 写法的原因见 matrix_power.h
+__attribute__((target("avx512f")))
+inline uint32_t dotAvx512(const uint32_t* a, const uint32_t* b, size_t len, const DotContext& ctx) {
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+    __m512i vr = _mm512_set1_epi64(ctx.r), low = _mm512_set1_epi64(0xFFFFFFFFu);
+    size_t i = 0, sinceFold = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m512i va = _mm512_loadu_si512((const void*)(a + i));
+        __m512i vb = _mm512_loadu_si512((const void*)(b + i));
+        acc0 = _mm512_add_epi64(acc0, _mm512_maskz_mul_epu32(0xFF, va, vb));
+        acc1 = _mm512_add_epi64(acc1, _mm512_maskz_mul_epu32(0xFF, _mm512_maskz_srli_epi64(0xFF, va, 32),
+                                                             _mm512_maskz_srli_epi64(0xFF, vb, 32)));
+        if (++sinceFold == ctx.block) {
+            acc0 = foldLanesAvx512(acc0, vr, low), acc1 = foldLanesAvx512(acc1, vr, low);
+            sinceFold = 0;
+        }
+    }
+    alignas(64) uint64_t lanes[17];
+    _mm512_store_si512((void*)lanes, foldLanesAvx512(acc0, vr, low));
+    _mm512_store_si512((void*)(lanes + 8), foldLanesAvx512(acc1, vr, low));
+    lanes[16] = dotScalar(a + i, b + i, len - i, ctx);
+    return ctx.finish(lanes, 17);
+}
+#endif
+
+typedef uint32_t (*DotKernel)(const uint32_t*, const uint32_t*, size_t, const DotContext&);
+
+inline DotKernel dotKernel() {
+    static const DotKernel k = []() -> DotKernel {
+#ifdef MATRIX_POWER_X86
+        if (__builtin_cpu_supports("avx512f")) return dotAvx512;
+        if (__builtin_cpu_supports("avx2")) return dotAvx2;
+#endif
+        return dotScalar;
+    }();
+    return k;
+}
+
+}  // namespace subsequence_chain_detail
+
+class SubsequenceChainCounter {
+    const PrefixTables& tables;
+    uint32_t mod;
+    subsequence_chain_detail::DotContext ctx;
+
+    // 倒序存放：head[len-1-t] = invFact[t] · x^t，tail[len-1-j] = invFact[j] · x^{-j}
+    std::vector<uint32_t> head, tail;
+
+    uint32_t power(uint32_t a, uint64_t e) const {
+        uint32_t r = 1;
+        for (; e; e >>= 1, a = ctx.br.mul(a, a)) {
+            if (e & 1) r = ctx.br.mul(r, a);
+        }
+        return r;
+    }
+
+    // out[len-1-t] = invFact[t] · base^t，t < len；x 的幂分四条链交错递推
+    void buildReversed(std::vector<uint32_t>& out, size_t len, uint32_t base) const {
+        out.resize(len);
+        const uint32_t* invFact = tables.invFactData();
+        uint32_t* dst = out.data() + len - 1;
+        uint32_t p[4], step = ctx.br.mul(ctx.br.mul(base, base), ctx.br.mul(base, base));
+        p[0] = 1;
+        for (int k = 1; k < 4; k++) p[k] = ctx.br.mul(p[k - 1], base);
+        size_t t = 0;
+        for (; t + 4 <= len; t += 4) {
+            for (int k = 0; k < 4; k++) {
+                dst[-(ptrdiff_t)(t + k)] = ctx.br.mul(invFact[t + k], p[k]);
+                p[k] = ctx.br.mul(p[k], step);
+            }
+        }
+        for (int k = 0; t < len; t++, k++) dst[-(ptrdiff_t)t] = ctx.br.mul(invFact[t], p[k]);
+    }
+
+public:
+    // tables 须为素数模数的表，且在本对象使用期间保持有效
+    explicit SubsequenceChainCounter(const PrefixTables& tables)
+        : tables(tables), mod(tables.mod()), ctx(tables.mod()) {}
+
+    // w[i-1] = W(a[i-1], a[i])，i = 1..n-1。a 须严格递减、a[0] ≤ tables.size()，否则返回 false
+    bool weights(uint64_t m, const std::vector<uint64_t>& a, std::vector<uint32_t>& w) {
+        w.clear();
+        if (a.empty() || a[0] > tables.size()) return false;
+        for (size_t i = 1; i < a.size(); i++) {
+            if (a[i] >= a[i - 1]) return false;
+        }
+        uint32_t mm = (uint32_t)(m % mod), x = (mm + mod - 1) % mod;
+        w.assign(a.size() - 1, 1);
+        if (x == 0) return true;   // 只有一种字符：W ≡ 1
+
+        // 先定下每一步用正面还是补集，据此决定两张表各建多长
+        size_t headLen = 0, tailLen = 0;
+        for (size_t i = 1; i < a.size(); i++) {
+            uint64_t delta = a[i - 1] - a[i], b = a[i];
+            if (delta + 1 <= b) headLen = std::max<size_t>(headLen, delta + 1);
+            else tailLen = std::max<size_t>(tailLen, b);
+        }
+        if (headLen) buildReversed(head, headLen, x);
+        if (tailLen) buildReversed(tail, tailLen, inverseMod(x, mod));
+
+        const uint32_t* fact = tables.factData();
+        const uint32_t* invFact = tables.invFactData();
+        auto dot = subsequence_chain_detail::dotKernel();
+        for (size_t i = 1; i < a.size(); i++) {
+            uint64_t A = a[i - 1], b = a[i], delta = A - b;
+            if (delta + 1 <= b) {
+                uint32_t s = dot(head.data() + headLen - 1 - delta, invFact + (A - delta), delta + 1, ctx);
+                w[i - 1] = ctx.br.mul(fact[A], s);
+            } else {
+                uint32_t s = b ? dot(tail.data() + tailLen - b, invFact + (A - b + 1), b, ctx) : 0;
+                uint32_t rest = ctx.br.mul(ctx.br.mul(fact[A], power(x, A)), s);
+                uint32_t total = power(mm, A);
+                w[i - 1] = total >= rest ? total - rest : total + mod - rest;
+            }
+        }
+        return true;
+    }
+
+    // m^{a_n} · Π W(a_{i-1}, a_i)；输入不合法时返回 0
+    uint32_t count(uint64_t m, const std::vector<uint64_t>& a) {
+        std::vector<uint32_t> w;
+        if (!weights(m, a, w)) return 0;
+        uint32_t ans = power((uint32_t)(m % mod), a.back());
+        for (uint32_t v : w) ans = ctx.br.mul(ans, v);
+        return ans;
+    }
+};
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * 快速子集变换：正确性验证与性能测试
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 内核见 subset_transform.h，原理见 子集反演与FWT详解.md。
+ *
+ * 1. 小规模（n ≤ 8）与 O(4^n) 暴力卷积逐项比较，覆盖 OR / AND / XOR 三种卷积
+ *    与模数、整数两种版本，并检查 zeta → möbius、walsh → 逆 walsh 还原原数组
+ * 2. 性能：与文档中的朴素模板（逐层扫描整个数组、每步取模）对比，n 最大 26
+ *
+ * 编译运行：
+ *   g++ -O2 -std=c++17 -pthread subset_transform.cpp -o subset_transform
+ *   ./subset_transform [最大 n] [线程数]
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include "subset_transform.h"
+
+using namespace std;
+
+const uint32_t MOD = 998244353;
+typedef ModSubsetTransform<MOD> ModTransform;
+
+// =============================================================================
+// 朴素模板（与 子集反演与FWT详解.md 第6节一致），作为性能基准
+// =============================================================================
+
+void naive_zeta_subset(vector<long long>& f, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int mask = 0; mask < (1 << n); mask++) {
+            if (mask & (1 << i)) f[mask] = (f[mask] + f[mask ^ (1 << i)]) % MOD;
+        }
+    }
+}
+
+void naive_fwht_mod(vector<long long>& a) {
+    int n = a.size();
+    for (int len = 1; len < n; len <<= 1) {
+        for (int i = 0; i < n; i += len << 1) {
+            for (int j = 0; j < len; j++) {
+                long long u = a[i + j], v = a[i + j + len];
+                a[i + j] = (u + v) % MOD;
+                a[i + j + len] = (u - v + MOD) % MOD;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// 正确性验证
+// =============================================================================
+
+// 暴力卷积：op 为 0 / 1 / 2 分别表示 OR / AND / XOR
+template<typename T, typename Mul, typename Add>
+vector<T> brute_convolution(const vector<T>& f, const vector<T>& g, int op, Mul mul, Add add) {
+    size_t N = f.size();
+    vector<T> h(N, 0);
+    for (size_t a = 0; a < N; a++) {
+        for (size_t b = 0; b < N; b++) {
+            size_t s = op == 0 ? (a | b) : op == 1 ? (a & b) : (a ^ b);
+            h[s] = add(h[s], mul(f[a], g[b]));
+        }
+    }
+    return h;
+}
+
+void test_correctness() {
+    cout << "=== 正确性验证 ===" << endl;
+    mt19937_64 rng(42);
+    const char* names[] = {"OR", "AND", "XOR"};
+    bool same[3] = {true, true, true};   // 每种卷积在全部规模上是否都与暴力一致
+
+    for (int n = 0; n <= 8; n++) {
+        size_t N = (size_t)1 << n;
+        for (int threads : {1, 3}) {
+            vector<uint32_t> fm(N), gm(N);
+            vector<int64_t> fi(N), gi(N);
+            for (size_t i = 0; i < N; i++) {
+                fm[i] = rng() % MOD, gm[i] = rng() % MOD;
+                fi[i] = (int64_t)(rng() % 2001) - 1000, gi[i] = (int64_t)(rng() % 2001) - 1000;
+            }
+
+            for (int op = 0; op < 3; op++) {
+                vector<uint32_t> hm = op == 0 ? ModTransform::or_convolution(fm, gm, n, threads)
+                                    : op == 1 ? ModTransform::and_convolution(fm, gm, n, threads)
+                                              : ModTransform::xor_convolution(fm, gm, n, threads);
+                vector<uint32_t> bm = brute_convolution(fm, gm, op,
+                    [](uint32_t a, uint32_t b) { return (uint32_t)((uint64_t)a * b % MOD); },
+                    [](uint32_t a, uint32_t b) { return (a + b) % MOD; });
+
+                vector<int64_t> hi = op == 0 ? IntSubsetTransform::or_convolution(fi, gi, n, threads)
+                                   : op == 1 ? IntSubsetTransform::and_convolution(fi, gi, n, threads)
+                                             : IntSubsetTransform::xor_convolution(fi, gi, n, threads);
+                vector<int64_t> bi = brute_convolution(fi, gi, op,
+                    [](int64_t a, int64_t b) { return a * b; },
+                    [](int64_t a, int64_t b) { return a + b; });
+
+                if (same[op] && (hm != bm || hi != bi)) {
+                    cout << names[op] << " 卷积在 n = " << n << "、线程 " << threads << " 时出错" << endl;
+                    same[op] = false;
+                }
+            }
+        }
+    }
+    for (int op = 0; op < 3; op++) {
+        cout << names[op] << " 卷积（n ≤ 8，模数版与 int64 版）："
+             << (same[op] ? "✓ 与暴力一致" : "✗ 与暴力不一致") << endl;
+    }
+
+    // 大规模往返：跨过分块边界（第二遍生效）
+    for (int n : {15, 18, 21}) {
+        size_t N = (size_t)1 << n;
+        vector<uint32_t> a(N);
+        vector<int64_t> b(N);
+        for (size_t i = 0; i < N; i++) a[i] = rng() % MOD, b[i] = (int64_t)(rng() % 2001) - 1000;
+        vector<uint32_t> a0 = a;
+        vector<int64_t> b0 = b;
+
+        ModTransform::zeta_superset(a.data(), n, 2);
+        ModTransform::mobius_superset(a.data(), n, 2);
+        ModTransform::walsh(a.data(), n, false, 2);
+        ModTransform::walsh(a.data(), n, true, 2);
+        IntSubsetTransform::zeta_subset(b.data(), n, 2);
+        IntSubsetTransform::mobius_subset(b.data(), n, 2);
+        IntSubsetTransform::walsh(b.data(), n, false, 2);
+        IntSubsetTransform::walsh(b.data(), n, true, 2);
+        cout << "n = " << n << " 正逆变换往返：" << (a == a0 && b == b0 ? "✓ 还原" : "✗ 未还原");
+
+        // 与朴素 zeta / fwht 逐项比较
+        vector<long long> z(a0.begin(), a0.end()), w(a0.begin(), a0.end());
+        naive_zeta_subset(z, n);
+        naive_fwht_mod(w);
+        vector<uint32_t> za = a0, wa = a0;
+        ModTransform::zeta_subset(za.data(), n, 2);
+        ModTransform::walsh(wa.data(), n, false, 2);
+        size_t bad = 0;
+        while (bad < N && za[bad] == (uint32_t)z[bad] && wa[bad] == (uint32_t)w[bad]) bad++;
+        if (bad == N) cout << "，与朴素模板：✓ 一致" << endl;
+        else cout << "，与朴素模板：✗ 下标 " << bad << " 不一致" << endl;
+    }
+    cout << endl;
+}
+
+// =============================================================================
+// 性能测试
+// =============================================================================
+
+template<typename Func>
+double measure_ms(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void performance_test(int max_n, int threads) {
+    cout << "=== 性能测试（线程数 " << threads << "，AVX2 "
+         << (subset_transform_detail::cpu_has_avx2() ? "可用" : "不可用") << "）===" << endl;
+    mt19937_64 rng(7);
+
+    for (int n = 20; n <= max_n; n += 2) {
+        size_t N = (size_t)1 << n;
+        cout << "n = " << n << ":" << endl;
+
+        // 模数版本：朴素 FWHT / zeta 与分块内核
+        {
+            vector<uint32_t> a(N);
+            for (auto& x : a) x = rng() % MOD;
+
+            vector<long long> naive(a.begin(), a.end());
+            double t_naive_walsh = measure_ms([&] { naive_fwht_mod(naive); });
+            vector<uint32_t> fast = a;
+            double t_walsh_1 = measure_ms([&] { ModTransform::walsh(fast.data(), n, false, 1); });
+            bool ok = true;
+            for (size_t i = 0; i < N && ok; i++) ok = fast[i] == (uint32_t)naive[i];
+            double t_walsh_t = measure_ms([&] { ModTransform::walsh(a.data(), n, false, threads); });
+
+            naive.assign(a.begin(), a.end());
+            double t_naive_zeta = measure_ms([&] { naive_zeta_subset(naive, n); });
+            double t_zeta_t = measure_ms([&] { ModTransform::zeta_subset(a.data(), n, threads); });
+            for (size_t i = 0; i < N && ok; i++) ok = a[i] == (uint32_t)naive[i];
+
+            printf("  模 %u  XOR: 朴素 %9.1f ms, 内核(1线程) %8.1f ms, 内核(%d线程) %8.1f ms\n",
+                   MOD, t_naive_walsh, t_walsh_1, threads, t_walsh_t);
+            printf("  模 %u  OR : 朴素 %9.1f ms, 内核(%d线程) %8.1f ms%s\n",
+                   MOD, t_naive_zeta, threads, t_zeta_t, ok ? "" : "  [结果不一致]");
+        }
+
+        // 整数版本：超集 zeta 与 XOR 卷积
+        {
+            vector<int64_t> f(N), g(N);
+            for (size_t i = 0; i < N; i++) f[i] = rng() % 16, g[i] = rng() % 16;
+            vector<int64_t> z = f;
+            double t_zeta = measure_ms([&] { IntSubsetTransform::zeta_superset(z.data(), n, threads); });
+            double t_conv = measure_ms([&] { f = IntSubsetTransform::xor_convolution(f, g, n, threads); });
+            printf("  int64     AND zeta: %8.1f ms, XOR 卷积: %8.1f ms\n", t_zeta, t_conv);
+        }
+    }
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int max_n = argc > 1 ? atoi(argv[1]) : 26;
+    int threads = argc > 2 ? atoi(argv[2]) : max(1u, thread::hardware_concurrency());
+
+    test_correctness();
+    performance_test(max_n, threads);
+
+    return 0;
+}
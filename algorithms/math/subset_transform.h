@@ -0,0 +1,355 @@
+/*
+ * 快速子集变换内核库：Zeta / Möbius（OR、AND）与 Walsh–Hadamard（XOR）
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * 原理与朴素模板见 子集反演与FWT详解.md，本文件是面向 2^20 ~ 2^26 长度数组的实现：
+ *
+ * 1. 分块（缓存友好）
+ *    把长度 N = 2^n 的数组看成 R 行 × B 列（B 个元素约 256KB）。
+ *    - 第一遍：逐块完成低 log B 层蝶形，每块只在 L2 中反复读写
+ *    - 第二遍：高 log R 层只在行之间配对；按列切成约 1MB 的竖条，
+ *      一个竖条完成全部高层后再处理下一个
+ *    无论 n 多大，整个变换只扫描内存两遍，而朴素写法每层扫描一遍（n 遍）。
+ * 2. 向量化：蝶形内核有 AVX2 版本（运行时检测 CPU 支持），否则使用标量版本
+ * 3. 多线程：第一遍的块之间、第二遍的竖条之间互不相关，按线程均分
+ *
+ * 元素类型：
+ * - IntOps          int64_t，普通加减乘（溢出由调用方保证不发生）
+ * - ModOps<MOD>     uint32_t，取值 [0, MOD)，MOD 为小于 2^30 的奇素数
+ *
+ * 用法：
+ *   ModSubsetTransform<998244353>::xor_convolution(f, g, n, threads);
+ *   IntSubsetTransform::zeta_subset(a.data(), n, threads);
+ *
+ * 时间复杂度：O(n · 2^n)，内存访问 O(2^n)（两遍）
+ */
+
+#ifndef SUBSET_TRANSFORM_H
+#define SUBSET_TRANSFORM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SUBSET_TRANSFORM_X86 1
+#define SUBSET_TRANSFORM_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace subset_transform_detail {
+
+// 五种蝶形（lo 为该位为 0 的元素，hi 为该位为 1 的元素）
+enum class Butterfly {
+    ZetaSubset,       // hi += lo
+    MobiusSubset,     // hi -= lo
+    ZetaSuperset,     // lo += hi
+    MobiusSuperset,   // lo -= hi
+    Walsh             // (lo, hi) = (lo + hi, lo - hi)
+};
+
+// 在 [0, count) 上按线程均分执行 body(begin, end)
+template<typename Body>
+void parallel_for(size_t count, int threads, Body&& body) {
+    threads = (int)std::min<size_t>(std::max(1, threads), count);
+    if (threads <= 1) {
+        body((size_t)0, count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        size_t begin = count * t / threads, end = count * (t + 1) / threads;
+        workers.emplace_back([&body, begin, end] { body(begin, end); });
+    }
+    for (auto& w : workers) w.join();
+}
+
+inline bool cpu_has_avx2() {
+#ifdef SUBSET_TRANSFORM_X86
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+#else
+    return false;
+#endif
+}
+
+}  // namespace subset_transform_detail
+
+// 整数版本
+struct IntOps {
+    typedef int64_t T;
+    static const int LANES = 4;
+
+    static T add(T a, T b) { return a + b; }
+    static T sub(T a, T b) { return a - b; }
+    static T mul(T a, T b) { return a * b; }
+
+    // Walsh 逆变换：整体除以 N（结果为整数时精确）
+    static void scale_inverse(T* a, size_t count, int n) {
+        for (size_t i = 0; i < count; i++) a[i] /= (T)1 << n;
+    }
+
+#ifdef SUBSET_TRANSFORM_X86
+    SUBSET_TRANSFORM_AVX2 static __m256i add(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }
+    SUBSET_TRANSFORM_AVX2 static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi64(a, b); }
+#endif
+};
+
+// 模 MOD 版本
+template<uint32_t MOD>
+struct ModOps {
+    static_assert(MOD % 2 == 1 && MOD < (1u << 30), "MOD 必须是小于 2^30 的奇数");
+
+    typedef uint32_t T;
+    static const int LANES = 8;
+
+    static T add(T a, T b) {
+        T s = a + b;
+        return s >= MOD ? s - MOD : s;
+    }
+    static T sub(T a, T b) { return a >= b ? a - b : a + MOD - b; }
+    static T mul(T a, T b) { return (uint64_t)a * b % MOD; }
+
+    static T power(T a, uint64_t e) {
+        T r = 1;
+        while (e) {
+            if (e & 1) r = mul(r, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return r;
+    }
+
+    // Walsh 逆变换：乘以 N 的逆元
+    static void scale_inverse(T* a, size_t count, int n) {
+        T inv = power(power(2, n), MOD - 2);
+        for (size_t i = 0; i < count; i++) a[i] = mul(a[i], inv);
+    }
+
+#ifdef SUBSET_TRANSFORM_X86
+    // a + b 与 a + b - MOD 中取无符号较小者：不足 MOD 时后者回绕成很大的数
+    SUBSET_TRANSFORM_AVX2 static __m256i add(__m256i a, __m256i b) {
+        __m256i s = _mm256_add_epi32(a, b);
+        return _mm256_min_epu32(s, _mm256_sub_epi32(s, _mm256_set1_epi32(MOD)));
+    }
+    SUBSET_TRANSFORM_AVX2 static __m256i sub(__m256i a, __m256i b) {
+        __m256i d = _mm256_sub_epi32(a, b);
+        return _mm256_min_epu32(d, _mm256_add_epi32(d, _mm256_set1_epi32(MOD)));
+    }
+#endif
+};
+
+template<typename Ops>
+class SubsetTransform {
+public:
+    typedef typename Ops::T T;
+
+private:
+    typedef subset_transform_detail::Butterfly Butterfly;
+    typedef void (*Kernel)(T*, T*, size_t);
+    typedef void (*BlockKernel)(T*, size_t);
+
+    static const size_t BLOCK_BYTES = 256 << 10;   // 第一遍的块大小（L2 的一部分）
+    static const size_t STRIP_BYTES = 1 << 20;     // 第二遍的竖条大小
+
+    template<Butterfly B>
+    static void butterfly_scalar(T* lo, T* hi, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            if constexpr (B == Butterfly::ZetaSubset) hi[i] = Ops::add(hi[i], lo[i]);
+            if constexpr (B == Butterfly::MobiusSubset) hi[i] = Ops::sub(hi[i], lo[i]);
+            if constexpr (B == Butterfly::ZetaSuperset) lo[i] = Ops::add(lo[i], hi[i]);
+            if constexpr (B == Butterfly::MobiusSuperset) lo[i] = Ops::sub(lo[i], hi[i]);
+            if constexpr (B == Butterfly::Walsh) {
+                T u = lo[i], v = hi[i];
+                lo[i] = Ops::add(u, v);
+                hi[i] = Ops::sub(u, v);
+            }
+        }
+    }
+
+#ifdef SUBSET_TRANSFORM_X86
+    template<Butterfly B>
+    SUBSET_TRANSFORM_AVX2 static void butterfly_avx2(T* lo, T* hi, size_t len) {
+        size_t i = 0;
+        for (; i + Ops::LANES <= len; i += Ops::LANES) {
+            __m256i u = _mm256_loadu_si256((const __m256i*)(lo + i));
+            __m256i v = _mm256_loadu_si256((const __m256i*)(hi + i));
+            if constexpr (B == Butterfly::ZetaSubset) {
+                _mm256_storeu_si256((__m256i*)(hi + i), Ops::add(v, u));
+            }
+            if constexpr (B == Butterfly::MobiusSubset) {
+                _mm256_storeu_si256((__m256i*)(hi + i), Ops::sub(v, u));
+            }
+            if constexpr (B == Butterfly::ZetaSuperset) {
+                _mm256_storeu_si256((__m256i*)(lo + i), Ops::add(u, v));
+            }
+            if constexpr (B == Butterfly::MobiusSuperset) {
+                _mm256_storeu_si256((__m256i*)(lo + i), Ops::sub(u, v));
+            }
+            if constexpr (B == Butterfly::Walsh) {
+                _mm256_storeu_si256((__m256i*)(lo + i), Ops::add(u, v));
+                _mm256_storeu_si256((__m256i*)(hi + i), Ops::sub(u, v));
+            }
+        }
+        butterfly_scalar<B>(lo + i, hi + i, len - i);
+    }
+#endif
+
+    // 一个块内的全部低层
+    template<Butterfly B>
+    static void block_scalar(T* base, size_t block) {
+        for (size_t stride = 1; stride < block; stride <<= 1) {
+            for (size_t j = 0; j < block; j += 2 * stride) butterfly_scalar<B>(base + j, base + j + stride, stride);
+        }
+    }
+
+#ifdef SUBSET_TRANSFORM_X86
+    // 向量内部的一层：partner 为间隔 BYTES 字节的配对元素，hi 标记该位为 1 的通道
+    template<Butterfly B, int BYTES>
+    SUBSET_TRANSFORM_AVX2 static __m256i in_register_step(__m256i x) {
+        __m256i p, hi;
+        if constexpr (BYTES == 4) {
+            p = _mm256_shuffle_epi32(x, 0xB1);
+            hi = _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+        }
+        if constexpr (BYTES == 8) {
+            p = _mm256_shuffle_epi32(x, 0x4E);
+            hi = _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+        }
+        if constexpr (BYTES == 16) {
+            p = _mm256_permute2x128_si256(x, x, 1);
+            hi = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+        }
+        if constexpr (B == Butterfly::ZetaSubset) return _mm256_blendv_epi8(x, Ops::add(x, p), hi);
+        if constexpr (B == Butterfly::MobiusSubset) return _mm256_blendv_epi8(x, Ops::sub(x, p), hi);
+        if constexpr (B == Butterfly::ZetaSuperset) return _mm256_blendv_epi8(Ops::add(x, p), x, hi);
+        if constexpr (B == Butterfly::MobiusSuperset) return _mm256_blendv_epi8(Ops::sub(x, p), x, hi);
+        if constexpr (B == Butterfly::Walsh) return _mm256_blendv_epi8(Ops::add(x, p), Ops::sub(p, x), hi);
+    }
+
+    // 间隔小于一个向量的几层在寄存器里一次做完，其余层整段向量化
+    template<Butterfly B>
+    SUBSET_TRANSFORM_AVX2 static void block_avx2(T* base, size_t block) {
+        if (block < (size_t)Ops::LANES) {
+            block_scalar<B>(base, block);
+            return;
+        }
+        for (size_t i = 0; i < block; i += Ops::LANES) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(base + i));
+            if constexpr (sizeof(T) == 4) x = in_register_step<B, 4>(x);
+            x = in_register_step<B, 8>(x);
+            x = in_register_step<B, 16>(x);
+            _mm256_storeu_si256((__m256i*)(base + i), x);
+        }
+        for (size_t stride = Ops::LANES; stride < block; stride <<= 1) {
+            for (size_t j = 0; j < block; j += 2 * stride) butterfly_avx2<B>(base + j, base + j + stride, stride);
+        }
+    }
+#endif
+
+    template<Butterfly B>
+    static Kernel select_kernel() {
+#ifdef SUBSET_TRANSFORM_X86
+        if (subset_transform_detail::cpu_has_avx2()) return &butterfly_avx2<B>;
+#endif
+        return &butterfly_scalar<B>;
+    }
+
+    template<Butterfly B>
+    static BlockKernel select_block_kernel() {
+#ifdef SUBSET_TRANSFORM_X86
+        if (subset_transform_detail::cpu_has_avx2()) return &block_avx2<B>;
+#endif
+        return &block_scalar<B>;
+    }
+
+    template<Butterfly B>
+    static void transform(T* a, int n, int threads) {
+        using subset_transform_detail::parallel_for;
+        Kernel kernel = select_kernel<B>();
+        BlockKernel block_kernel = select_block_kernel<B>();
+        size_t N = (size_t)1 << n;
+
+        // 第一遍：每块 2^low 个元素，块内完成低 low 层
+        int low = 0;
+        while (low < n && ((size_t)2 << low) * sizeof(T) <= BLOCK_BYTES) low++;
+        size_t block = (size_t)1 << low;
+        parallel_for(N / block, threads, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; b++) block_kernel(a + b * block, block);
+        });
+        if (low == n) return;
+
+        // 第二遍：R 行 × block 列，高层在行之间配对，按竖条完成
+        size_t rows = N / block;
+        size_t width = std::max<size_t>(Ops::LANES * 2, STRIP_BYTES / (rows * sizeof(T)));
+        width = std::min(width, block);
+        size_t strips = block / width;
+        parallel_for(strips, threads, [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; s++) {
+                T* base = a + s * width;
+                for (size_t stride = 1; stride < rows; stride <<= 1) {
+                    for (size_t r = 0; r < rows; r += 2 * stride) {
+                        for (size_t k = r; k < r + stride; k++) {
+                            kernel(base + k * block, base + (k + stride) * block, width);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    static void pointwise(std::vector<T>& f, const std::vector<T>& g, int threads) {
+        subset_transform_detail::parallel_for(f.size(), threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) f[i] = Ops::mul(f[i], g[i]);
+        });
+    }
+
+public:
+    // F[S] = Σ_{T ⊆ S} f[T]
+    static void zeta_subset(T* a, int n, int threads = 1) { transform<Butterfly::ZetaSubset>(a, n, threads); }
+    static void mobius_subset(T* a, int n, int threads = 1) { transform<Butterfly::MobiusSubset>(a, n, threads); }
+    // F[S] = Σ_{T ⊇ S} f[T]
+    static void zeta_superset(T* a, int n, int threads = 1) { transform<Butterfly::ZetaSuperset>(a, n, threads); }
+    static void mobius_superset(T* a, int n, int threads = 1) { transform<Butterfly::MobiusSuperset>(a, n, threads); }
+
+    // 未归一的 Walsh–Hadamard 变换；invert 时再整体除以 N
+    static void walsh(T* a, int n, bool invert, int threads = 1) {
+        transform<Butterfly::Walsh>(a, n, threads);
+        if (invert) Ops::scale_inverse(a, (size_t)1 << n, n);
+    }
+
+    // h[S] = Σ_{A ∪ B = S} f[A] g[B]
+    static std::vector<T> or_convolution(std::vector<T> f, std::vector<T> g, int n, int threads = 1) {
+        zeta_subset(f.data(), n, threads);
+        zeta_subset(g.data(), n, threads);
+        pointwise(f, g, threads);
+        mobius_subset(f.data(), n, threads);
+        return f;
+    }
+
+    // h[S] = Σ_{A ∩ B = S} f[A] g[B]
+    static std::vector<T> and_convolution(std::vector<T> f, std::vector<T> g, int n, int threads = 1) {
+        zeta_superset(f.data(), n, threads);
+        zeta_superset(g.data(), n, threads);
+        pointwise(f, g, threads);
+        mobius_superset(f.data(), n, threads);
+        return f;
+    }
+
+    // h[S] = Σ_{A ⊕ B = S} f[A] g[B]
+    static std::vector<T> xor_convolution(std::vector<T> f, std::vector<T> g, int n, int threads = 1) {
+        walsh(f.data(), n, false, threads);
+        walsh(g.data(), n, false, threads);
+        pointwise(f, g, threads);
+        walsh(f.data(), n, true, threads);
+        return f;
+    }
+};
+
+typedef SubsetTransform<IntOps> IntSubsetTransform;
+template<uint32_t MOD>
+using ModSubsetTransform = SubsetTransform<ModOps<MOD>>;
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * 任意位宽的异或线性基模板
+ * 千禧年科技学院 - ユウカ高等数学专题
+ *
+ * XORLinearBasis<BITS>：
+ * - BITS = 32  元素类型 uint32_t
+ * - BITS = 64  元素类型 uint64_t
+ * - BITS = 128 / 256 / ... 元素类型 WideWord<BITS/64>（64位字数组）
+ *
+ * 插入时用 __builtin_clz / __builtin_clzll 直接定位最高位（主元），
+ * 而不是从最高位逐位扫描，每次消元跳过所有为0的位。
+ *
+ * 支持：insert / canInsert / canRepresent / getMaxValue / kthSmallest / merge
+ *
+ * 时间复杂度：插入 O(r · BITS/64)，r 为当前基的大小
+ * 空间复杂度：O(BITS · BITS/64) 个字
+ */
+
+#ifndef XOR_LINEAR_BASIS_H
+#define XOR_LINEAR_BASIS_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 由 WORDS 个 64 位字组成的大整数，w[0] 为最低位
+template<int WORDS>
+struct WideWord {
+    uint64_t w[WORDS];
+
+    WideWord() { memset(w, 0, sizeof(w)); }
+    WideWord(uint64_t low) {
+        memset(w, 0, sizeof(w));
+        w[0] = low;
+    }
+
+    WideWord& operator^=(const WideWord& other) {
+        for (int i = 0; i < WORDS; i++) w[i] ^= other.w[i];
+        return *this;
+    }
+    WideWord operator^(const WideWord& other) const {
+        WideWord res = *this;
+        res ^= other;
+        return res;
+    }
+    bool operator==(const WideWord& other) const {
+        return memcmp(w, other.w, sizeof(w)) == 0;
+    }
+    bool operator!=(const WideWord& other) const { return !(*this == other); }
+    bool operator<(const WideWord& other) const {
+        for (int i = WORDS - 1; i >= 0; i--) {
+            if (w[i] != other.w[i]) return w[i] < other.w[i];
+        }
+        return false;
+    }
+    bool operator>(const WideWord& other) const { return other < *this; }
+    explicit operator bool() const {
+        for (int i = 0; i < WORDS; i++) if (w[i]) return true;
+        return false;
+    }
+};
+
+template<int WORDS>
+std::ostream& operator<<(std::ostream& os, const WideWord<WORDS>& x) {
+    static const char* digits = "0123456789abcdef";
+    std::string s = "0x";
+    bool leading = true;
+    for (int i = WORDS - 1; i >= 0; i--) {
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            int d = (x.w[i] >> shift) & 15;
+            if (leading && d == 0 && !(i == 0 && shift == 0)) continue;
+            leading = false;
+            s += digits[d];
+        }
+    }
+    return os << s;
+}
+
+namespace xor_basis_detail {
+
+// 最高位下标，x 必须非零
+inline int highestBit(uint32_t x) { return 31 - __builtin_clz(x); }
+inline int highestBit(uint64_t x) { return 63 - __builtin_clzll(x); }
+template<int WORDS>
+inline int highestBit(const WideWord<WORDS>& x) {
+    for (int i = WORDS - 1; i >= 0; i--) {
+        if (x.w[i]) return i * 64 + 63 - __builtin_clzll(x.w[i]);
+    }
+    return -1;
+}
+
+inline bool testBit(uint32_t x, int i) { return x >> i & 1; }
+inline bool testBit(uint64_t x, int i) { return x >> i & 1; }
+template<int WORDS>
+inline bool testBit(const WideWord<WORDS>& x, int i) { return x.w[i >> 6] >> (i & 63) & 1; }
+
+inline bool isZero(uint32_t x) { return x == 0; }
+inline bool isZero(uint64_t x) { return x == 0; }
+template<int WORDS>
+inline bool isZero(const WideWord<WORDS>& x) { return !static_cast<bool>(x); }
+
+template<int BITS>
+struct WordOf { typedef WideWord<(BITS + 63) / 64> type; };
+template<> struct WordOf<32> { typedef uint32_t type; };
+template<> struct WordOf<64> { typedef uint64_t type; };
+
+}  // namespace xor_basis_detail
+
+template<int BITS = 32>
+class XORLinearBasis {
+    static_assert(BITS == 32 || BITS % 64 == 0, "位宽必须是 32 或 64 的倍数");
+
+public:
+    typedef typename xor_basis_detail::WordOf<BITS>::type Word;
+
+private:
+    Word basis[BITS];     // basis[i] 的最高位恰为 i，为0表示该位没有主元
+    int size;
+    bool hasDependent;    // 是否插入过线性相关的数（此时0可以由非空子集表示）
+
+public:
+    XORLinearBasis() : size(0), hasDependent(false) {
+        for (int i = 0; i < BITS; i++) basis[i] = Word();
+    }
+
+    // 插入数字，线性无关时返回 true
+    bool insert(Word x) {
+        using namespace xor_basis_detail;
+        while (!isZero(x)) {
+            int pivot = highestBit(x);
+            if (isZero(basis[pivot])) {
+                basis[pivot] = x;
+                size++;
+                return true;
+            }
+            x ^= basis[pivot];
+        }
+        hasDependent = true;
+        return false;
+    }
+
+    // 合并另一个线性基：把它的每个基向量插入当前基，结果张成两者的和空间
+    // 返回新增的基向量个数；当前基满秩后提前结束
+    int merge(const XORLinearBasis& other) {
+        using namespace xor_basis_detail;
+        int added = 0;
+        for (int i = BITS - 1; i >= 0 && size < BITS; i--) {
+            if (!isZero(other.basis[i]) && insert(other.basis[i])) added++;
+        }
+        if (other.hasDependent) hasDependent = true;
+        return added;
+    }
+
+    // 是否已满秩（此后任何插入都不会改变张成的空间）
+    bool isFull() const { return size == BITS; }
+
+    // 检查是否可以插入（是否与当前基线性无关）
+    bool canInsert(Word x) const {
+        using namespace xor_basis_detail;
+        while (!isZero(x)) {
+            int pivot = highestBit(x);
+            if (isZero(basis[pivot])) return true;
+            x ^= basis[pivot];
+        }
+        return false;
+    }
+
+    // 检查数字是否可以由基表示
+    bool canRepresent(Word x) const { return !canInsert(x); }
+
+    // 获取能表示的最大值
+    Word getMaxValue() const {
+        using namespace xor_basis_detail;
+        Word result = Word();
+        for (int i = BITS - 1; i >= 0; i--) {
+            if (!isZero(basis[i]) && !testBit(result, i)) result ^= basis[i];
+        }
+        return result;
+    }
+
+    // 非空子集异或值（去重后）从小到大第k个，k从1开始；不存在时返回 false
+    bool kthSmallest(unsigned long long k, Word& out) const {
+        using namespace xor_basis_detail;
+        if (hasDependent) {
+            if (k == 1) {
+                out = Word();
+                return true;
+            }
+            k--;
+        }
+        if (k == 0 || (size < 64 && k >= (1ULL << size))) return false;
+
+        // 化为简化阶梯形：每个主元位只在自己的基向量中为1
+        std::vector<Word> reduced;
+        Word rows[BITS];
+        for (int i = 0; i < BITS; i++) rows[i] = basis[i];
+        for (int i = 0; i < BITS; i++) {
+            if (isZero(rows[i])) continue;
+            for (int j = i + 1; j < BITS; j++) {
+                if (!isZero(rows[j]) && testBit(rows[j], i)) rows[j] ^= rows[i];
+            }
+            reduced.push_back(rows[i]);
+        }
+
+        // k 的二进制位对应选择哪些基向量
+        Word result = Word();
+        for (size_t j = 0; j < reduced.size() && j < 64; j++) {
+            if (k >> j & 1) result ^= reduced[j];
+        }
+        out = result;
+        return true;
+    }
+
+    // 获取基中所有数字（按主元从低到高）
+    std::vector<Word> getBasis() const {
+        std::vector<Word> result;
+        for (int i = 0; i < BITS; i++) {
+            if (!xor_basis_detail::isZero(basis[i])) result.push_back(basis[i]);
+        }
+        return result;
+    }
+
+    // 获取基的大小
+    int getSize() const { return size; }
+
+    // 基中数字的总和（仅对 32/64 位有意义）
+    unsigned long long getSum() const {
+        static_assert(std::is_integral<Word>::value, "getSum 只支持 32/64 位");
+        unsigned long long sum = 0;
+        for (int i = 0; i < BITS; i++) sum += basis[i];
+        return sum;
+    }
+
+    bool containsZero() const { return hasDependent; }
+};
+
+#endif
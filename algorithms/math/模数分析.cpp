@@ -9,17 +9,20 @@ using namespace std;
  */
 
 /**
- * 计算组合数C(n,k)
+ * 计算组合数C(n,k)（精确值，要求结果不超过 long long）
+ * 
+ * 第 i 步的 result = C(n-k+i, i)，乘法在 128 位里做，中间值不会溢出；
+ * n 更大时应直接求 C(n,k) mod p，见 lucas_binomial.h
  */
 long long combination(int n, int k) {
     if (k > n || k < 0) return 0;
-    if (k == 0 || k == n) return 1;
+    if (k > n - k) k = n - k;
     
-    long long result = 1;
-    for (int i = 0; i < k; i++) {
-        result = result * (n - i) / (i + 1);
+    unsigned __int128 result = 1;
+    for (int i = 1; i <= k; i++) {
+        result = result * (n - k + i) / i;
     }
-    return result;
+    return (long long)result;
 }
 
 /**
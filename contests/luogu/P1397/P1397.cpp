@@ -1,199 +1,121 @@
 #include <iostream>
 #include <string>
+#include <vector>
 using namespace std;
 
 const long long MOD = 1000000007;
 
-long long power_mod(long long base, long long exp, long long mod) {
-    long long result = 1;
-    base %= mod;
-    while (exp > 0) {
-        if (exp & 1) result = (result * base) % mod;
-        base = (base * base) % mod;
-        exp >>= 1;
-    }
-    return result;
-}
+// 形如 [[x, y], [0, 1]]、x ≢ 0 的矩阵（模 MOD）的阶都整除 MOD·(MOD-1)：
+// x ≠ 1 时可对角化为 diag(x, 1)，x^(MOD-1) = 1；x = 1 时 [[1, y], [0, 1]]^k = [[1, k·y], [0, 1]]，周期 MOD。
+// 只按 MOD-1（费马小定理）约化指数对 x = 1 的情形是错的。
+// x ≡ 0 时矩阵幂等、不可逆，不能直接取余（通用做法见 algorithms/math/decimal_exponent.h 的 reduce）；
+// 本题 1 ≤ a, c ≤ 10^9 < MOD，A 与 C·A^(m-1) 的对角元 a、c·a^(m-1) 都不为 0
+const unsigned long long MATRIX_ORDER = (unsigned long long)MOD * (MOD - 1);
 
-long long string_mod(const string& s, long long mod) {
-    long long result = 0;
-    for (char c : s) {
-        result = (result * 10 + (c - '0')) % mod;
-    }
-    return result;
-}
-
-// 计算(s-1) mod mod，特别处理超大数
-long long string_minus_1_mod(const string& s, long long mod) {
-    if (s == "1") return 0;
-    
-    // 对于不太大的数，直接计算
-    if (s.length() <= 18) {
-        long long val = 0;
-        for (char c : s) {
-            val = val * 10 + (c - '0');
+// 十进制大整数（只作指数用），每 18 位一组，高位组在前
+// 提交版单文件自包含；通用版本与十进制窗口快速幂见 algorithms/math/decimal_exponent.h、matrix_power.h
+struct DecimalExponent {
+    static const int DIGITS = 18;
+    static const unsigned long long BASE = 1000000000000000000ULL;   // 10^18
+    
+    vector<unsigned long long> chunks;
+    
+    explicit DecimalExponent(const string& s) {
+        size_t head = s.size() % DIGITS;
+        if (head == 0) head = DIGITS;
+        for (size_t pos = 0; pos < s.size(); pos += (pos == 0 ? head : DIGITS)) {
+            size_t len = pos == 0 ? head : DIGITS;
+            unsigned long long v = 0;
+            for (size_t i = pos; i < pos + len; i++) v = v * 10 + (s[i] - '0');
+            chunks.push_back(v);
         }
-        return (val - 1) % mod;
     }
     
-    // 对于超大数，使用模运算
-    long long val = string_mod(s, mod);
-    return (val - 1 + mod) % mod;
-}
-
-// 矩阵快速幂（只处理指数不太大的情况）
-void matrix_power(long long mat[2][2], long long exp, long long result[2][2]) {
-    result[0][0] = result[1][1] = 1;
-    result[0][1] = result[1][0] = 0;
-    
-    if (exp == 0) return;
-    
-    long long base[2][2];
-    for (int i = 0; i < 2; i++) {
-        for (int j = 0; j < 2; j++) {
-            base[i][j] = mat[i][j];
-        }
+    bool is_zero() const {
+        for (unsigned long long c : chunks) if (c) return false;
+        return true;
     }
     
-    while (exp > 0) {
-        if (exp & 1) {
-            long long temp[2][2];
-            temp[0][0] = (result[0][0] * base[0][0] + result[0][1] * base[1][0]) % MOD;
-            temp[0][1] = (result[0][0] * base[0][1] + result[0][1] * base[1][1]) % MOD;
-            temp[1][0] = (result[1][0] * base[0][0] + result[1][1] * base[1][0]) % MOD;
-            temp[1][1] = (result[1][0] * base[0][1] + result[1][1] * base[1][1]) % MOD;
-            
-            for (int i = 0; i < 2; i++) {
-                for (int j = 0; j < 2; j++) {
-                    result[i][j] = temp[i][j];
-                }
+    // 减一（要求非零）
+    void decrement() {
+        for (size_t i = chunks.size(); i-- > 0; ) {
+            if (chunks[i] > 0) {
+                chunks[i]--;
+                return;
             }
+            chunks[i] = BASE - 1;
         }
-        
-        long long temp[2][2];
-        temp[0][0] = (base[0][0] * base[0][0] + base[0][1] * base[1][0]) % MOD;
-        temp[0][1] = (base[0][0] * base[0][1] + base[0][1] * base[1][1]) % MOD;
-        temp[1][0] = (base[1][0] * base[0][0] + base[1][1] * base[1][0]) % MOD;
-        temp[1][1] = (base[1][0] * base[0][1] + base[1][1] * base[1][1]) % MOD;
-        
-        for (int i = 0; i < 2; i++) {
-            for (int j = 0; j < 2; j++) {
-                base[i][j] = temp[i][j];
-            }
-        }
-        
-        exp >>= 1;
     }
-}
+    
+    // 对 m（m < 2^63）取模：每组一次 128 位运算，r·10^18 + chunk < 2^127
+    unsigned long long mod(unsigned long long m) const {
+        unsigned __int128 r = 0;
+        for (unsigned long long c : chunks) r = (r * BASE + c) % m;
+        return (unsigned long long)r;
+    }
+};
 
-long long solve(const string& n_str, const string& m_str, long long a, long long b, long long c, long long d) {
-    if (n_str == "1" && m_str == "1") return 1;
-    
-    // 判断数据规模
-    bool n_large = (n_str.length() > 18);
-    bool m_large = (m_str.length() > 18);
-    
-    // Case: m = 1
-    if (m_str == "1") {
-        if (n_str == "1") return 1;
-        
-        if (c == 1) {
-            long long n_minus_1_mod = string_minus_1_mod(n_str, MOD);
-            return (1 + n_minus_1_mod * d) % MOD;
-        } else {
-            // 对于超大的n，矩阵快速幂的指数处理需要特别小心
-            if (n_large) {
-                // 使用近似方法：假设矩阵的周期是MOD-1
-                long long exp = string_minus_1_mod(n_str, MOD - 1);
-                if (exp == 0 && n_str != "1") exp = MOD - 1;
-                
-                long long matrix[2][2] = {{c, d}, {0, 1}};
-                long long result[2][2];
-                matrix_power(matrix, exp, result);
-                return (result[0][0] + result[0][1]) % MOD;
-            } else {
-                long long n = 0;
-                for (char ch : n_str) {
-                    n = n * 10 + (ch - '0');
-                }
-                long long matrix[2][2] = {{c, d}, {0, 1}};
-                long long result[2][2];
-                matrix_power(matrix, n - 1, result);
-                return (result[0][0] + result[0][1]) % MOD;
-            }
-        }
+// K × K 矩阵，元素在 [0, MOD) 内
+template<int K>
+struct Matrix {
+    // K 个小于 MOD 的乘积之和不超过 2^64，每个元素只需取一次模
+    static_assert(K <= 18, "K 过大时需要分段取模");
+    
+    long long a[K][K];
+    
+    static Matrix identity() {
+        Matrix r = {};
+        for (int i = 0; i < K; i++) r.a[i][i] = 1;
+        return r;
     }
     
-    // Case: n = 1
-    if (n_str == "1") {
-        if (a == 1) {
-            long long m_minus_1_mod = string_minus_1_mod(m_str, MOD);
-            return (1 + b * m_minus_1_mod) % MOD;
-        } else {
-            long long exp = string_minus_1_mod(m_str, MOD - 1);
-            long long a_pow = power_mod(a, exp, MOD);
-            
-            if ((a - 1) % MOD == 0) {
-                long long m_minus_1_mod = string_minus_1_mod(m_str, MOD);
-                return (1 + b * m_minus_1_mod) % MOD;
-            } else {
-                long long inv = power_mod(a - 1, MOD - 2, MOD);
-                return (a_pow + b * (a_pow - 1 + MOD) % MOD * inv) % MOD;
+    Matrix operator*(const Matrix& o) const {
+        Matrix c;
+        for (int i = 0; i < K; i++) {
+            for (int j = 0; j < K; j++) {
+                unsigned long long s = 0;
+                for (int k = 0; k < K; k++) s += (unsigned long long)a[i][k] * o.a[k][j];
+                c.a[i][j] = s % MOD;
             }
         }
+        return c;
     }
-    
-    // Case: a = c = 1 (线性情况，可以直接计算)
-    if (a == 1 && c == 1) {
-        long long m_minus_1_mod = string_minus_1_mod(m_str, MOD);
-        long long n_minus_1_mod = string_minus_1_mod(n_str, MOD);
-        long long step = (b * m_minus_1_mod + d) % MOD;
-        long long f_n_1 = (1 + n_minus_1_mod * step) % MOD;
-        return (f_n_1 + b * m_minus_1_mod) % MOD;
+};
+
+// 矩阵快速幂，64 位指数
+template<int K>
+Matrix<K> matrix_power(Matrix<K> base, unsigned long long exp) {
+    Matrix<K> result = Matrix<K>::identity();
+    while (exp > 0) {
+        if (exp & 1) result = result * base;
+        base = base * base;
+        exp >>= 1;
     }
+    return result;
+}
+
+// 矩阵的十进制大指数幂：order 为矩阵阶的倍数，先把指数约化到 64 位，再做普通快速幂
+template<int K>
+Matrix<K> matrix_power(const Matrix<K>& base, const DecimalExponent& exp, unsigned long long order) {
+    return matrix_power(base, exp.mod(order));
+}
+
+// 状态向量 v = [F, 1]ᵀ：
+//   行内  v ← A v，A = [[a, b], [0, 1]]
+//   换行  v ← C v，C = [[c, d], [0, 1]]
+// 所以 v[n][m] = A^(m-1) · (C · A^(m-1))^(n-1) · [1, 1]ᵀ，不需要区分 a、c 是否为 1 或 n、m 的大小
+long long solve(const string& n_str, const string& m_str, long long a, long long b, long long c, long long d) {
+    DecimalExponent n(n_str), m(m_str);
+    n.decrement();
+    m.decrement();
     
-    // General case
-    long long m_minus_1_exp = string_minus_1_mod(m_str, MOD - 1);
-    long long m_minus_1_mod = string_minus_1_mod(m_str, MOD);
-    
-    long long coeff, const_term;
-    if (a == 1) {
-        coeff = 1;
-        const_term = (b * m_minus_1_mod) % MOD;
-    } else {
-        long long a_pow = power_mod(a, m_minus_1_exp, MOD);
-        coeff = a_pow;
-        
-        if ((a - 1) % MOD == 0) {
-            const_term = (b * m_minus_1_mod) % MOD;
-        } else {
-            long long inv = power_mod(a - 1, MOD - 2, MOD);
-            const_term = (b * (a_pow - 1 + MOD) % MOD * inv) % MOD;
-        }
-    }
+    Matrix<2> A = {{{a, b}, {0, 1}}};
+    Matrix<2> C = {{{c, d}, {0, 1}}};
     
-    // 矩阵快速幂
-    long long matrix[2][2] = {
-        {(c * coeff) % MOD, (c * const_term + d) % MOD},
-        {0, 1}
-    };
-    
-    long long result[2][2];
-    
-    if (n_large) {
-        long long exp = string_minus_1_mod(n_str, MOD - 1);
-        if (exp == 0 && n_str != "1") exp = MOD - 1;
-        matrix_power(matrix, exp, result);
-    } else {
-        long long n = 0;
-        for (char ch : n_str) {
-            n = n * 10 + (ch - '0');
-        }
-        matrix_power(matrix, n - 1, result);
-    }
+    Matrix<2> row = matrix_power(A, m, MATRIX_ORDER);
+    Matrix<2> result = row * matrix_power(C * row, n, MATRIX_ORDER);
     
-    long long f_n_1 = (result[0][0] + result[0][1]) % MOD;
-    return (coeff * f_n_1 + const_term) % MOD;
+    return (result.a[0][0] + result.a[0][1]) % MOD;
 }
 
 int main() {
@@ -210,4 +132,4 @@ int main() {
     cout << solve(n_str, m_str, a, b, c, d) << endl;
     
     return 0;
-} 
\ No newline at end of file
+}
@@ -27,11 +27,49 @@ struct HeapNode {
 
 int n, k, L, R;
 long long a[MAXN], sum[MAXN];  // 原数组和前缀和
-int b[MAXN], size_b;           // 离散化数组
+long long b[MAXN];             // 离散化数组（b[1..size_b]）
+int size_b;
+int rnk[MAXN];                 // rnk[i]：sum[i] 离散化后的位置
 int root[MAXN];                // 主席树根节点
 int node_cnt = 0;              // 主席树节点计数
 priority_queue<HeapNode> pq;   // 优先队列
 
+// 基数排序离散化（algorithms/data_structures/radix_discretizer.h 的精简版）
+// 对 key[0..m-1] 做 LSD 基数排序，写出去重后的 b[1..size_b] 与每个下标的排名 rnk[i]
+struct RadixItem {
+    unsigned long long key;
+    int index;
+} items[MAXN], buffer_items[MAXN];
+
+void radix_discretize(const long long* key, int m) {
+    for (int i = 0; i < m; i++) {
+        // 翻转符号位，负数前缀和也能按无符号比较
+        items[i].key = (unsigned long long)key[i] ^ (1ULL << 63);
+        items[i].index = i;
+    }
+    
+    static int cnt[256];
+    for (int shift = 0; shift < 64; shift += 8) {
+        memset(cnt, 0, sizeof(cnt));
+        for (int i = 0; i < m; i++) cnt[(items[i].key >> shift) & 255]++;
+        if (cnt[(items[0].key >> shift) & 255] == m) continue;  // 这一趟数字全相同
+        
+        for (int d = 1; d < 256; d++) cnt[d] += cnt[d - 1];
+        for (int i = m - 1; i >= 0; i--) {
+            buffer_items[--cnt[(items[i].key >> shift) & 255]] = items[i];
+        }
+        memcpy(items, buffer_items, sizeof(RadixItem) * m);
+    }
+    
+    size_b = 0;
+    for (int i = 0; i < m; i++) {
+        if (i == 0 || items[i].key != items[i - 1].key) {
+            b[++size_b] = key[items[i].index];
+        }
+        rnk[items[i].index] = size_b;
+    }
+}
+
 // 更新主席树
 void update(int& rt, int pre, int pos, int l, int r) {
     rt = ++node_cnt;
@@ -73,17 +111,12 @@ int main() {
         sum[i] = sum[i-1] + a[i];
     }
     
-    // 离散化前缀和
-    for (int i = 0; i <= n; i++) {
-        b[i+1] = sum[i];
-    }
-    sort(b + 1, b + n + 2);
-    size_b = unique(b + 1, b + n + 2) - b - 1;
+    // 离散化前缀和 sum[0..n]
+    radix_discretize(sum, n + 1);
     
-    // 建立主席树
+    // 建立主席树，离散化位置直接查排名数组
     for (int i = 0; i <= n; i++) {
-        int pos = lower_bound(b + 1, b + size_b + 1, sum[i]) - b;
-        update(root[i+1], root[i], pos, 1, size_b);
+        update(root[i+1], root[i], rnk[i], 1, size_b);
     }
     
     // 初始化堆：为每个左端点找到最大的区间